@@ -35,8 +35,16 @@ using namespace ORBIT;
 #define COMPONENT comp_ns
 #endif // COMPONENT
 
+#include "orbit_buffer.h"
 #include "orbit_uid.h"
+#include "orbit_event.h"
+#include "orbit_rate.h"
+#include "orbit_resolver.h"
+#include "orbit_ring.h"
 #include "orbit_socket.h"
+#include "orbit_utp.h"
+#include "orbit_shard.h"
+#include "orbit_task.h"
 
 using namespace ORBIT::COMPONENT;
 
@@ -48,18 +56,51 @@ namespace ORBIT {
 
 			~_orbit(void);
 
+			orbit_uid accept(
+				__in const orbit_uid &uid
+				);
+
 			static _orbit *acquire(void);
 
+			orbit_buffer_factory_ptr acquire_buffer_factory(void);
+
+			orbit_resolver_ptr acquire_resolver(void);
+
+			orbit_shard_ptr acquire_shard(
+				__in const orbit_uid &uid
+				);
+
+			orbit_shard_ptr acquire_shard(
+				__in size_t index
+				);
+
 			orbit_socket_factory_ptr acquire_socket_factory(void);
 
+			orbit_task_ptr acquire_task(void);
+
 			orbit_uid_factory_ptr acquire_uid_factory(void);
 
-			void initialize(void);
+			orbit_uid generate_tcp(
+				__in_opt const std::string &host = std::string(),
+				__in_opt uint16_t port = 0
+				);
+
+			orbit_uid generate_udp(
+				__in_opt const std::string &host = std::string(),
+				__in_opt uint16_t port = 0
+				);
+
+			void initialize(
+				__in_opt size_t shards = 0,
+				__in_opt size_t workers = 0
+				);
 
 			static bool is_allocated(void);
 
 			bool is_initialized(void);
 
+			size_t shard_count(void);
+
 			std::string to_string(
 				__in_opt bool verbose = false
 				);
@@ -82,14 +123,24 @@ namespace ORBIT {
 
 			static void _delete(void);
 
+			orbit_buffer_factory_ptr m_factory_buffer;
+
 			orbit_socket_factory_ptr m_factory_socket;
 
 			orbit_uid_factory_ptr m_factory_uid;
 
-			bool m_initialized;
+			std::atomic<bool> m_initialized;
 
 			static _orbit *m_instance;
 
+			orbit_resolver_ptr m_resolver;
+
+			std::vector<orbit_shard_ptr> m_shard;
+
+			std::atomic<size_t> m_shard_next;
+
+			orbit_task_ptr m_task;
+
 		private:
 
 			std::recursive_mutex m_lock;
@@ -0,0 +1,159 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_BUFFER_H_
+#define ORBIT_BUFFER_H_
+
+#include <atomic>
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		typedef enum {
+			ORBIT_BUFFER_CLASS_MESSAGE = 0,
+			ORBIT_BUFFER_CLASS_BLOCK,
+			ORBIT_BUFFER_CLASS_NONE,
+		} orbit_buffer_class_t;
+
+		#define ORBIT_BUFFER_CLASS_MAX ORBIT_BUFFER_CLASS_NONE
+
+		#define BUFFER_BLOCK_LEN 0x4000
+		#define BUFFER_MESSAGE_LEN 0x40
+
+		typedef struct _orbit_buffer_block {
+			std::atomic<size_t> reference;
+			size_t capacity;
+			size_t length;
+			orbit_buffer_class_t type;
+		} orbit_buffer_block, *orbit_buffer_block_ptr;
+
+		typedef class _orbit_buffer {
+
+			public:
+
+				_orbit_buffer(void);
+
+				explicit _orbit_buffer(
+					__in size_t length
+					);
+
+				_orbit_buffer(
+					__in const _orbit_buffer &other
+					);
+
+				~_orbit_buffer(void);
+
+				_orbit_buffer &operator=(
+					__in const _orbit_buffer &other
+					);
+
+				uint8_t &operator[](
+					__in size_t position
+					);
+
+				size_t capacity(void) const;
+
+				void clear(void);
+
+				uint8_t *data(void) const;
+
+				bool empty(void) const;
+
+				size_t length(void) const;
+
+				size_t reference_count(void) const;
+
+				void resize(
+					__in size_t length
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					) const;
+
+				orbit_buffer_class_t type(void) const;
+
+			protected:
+
+				orbit_buffer_block_ptr m_block;
+
+		} orbit_buffer, *orbit_buffer_ptr;
+
+		typedef class _orbit_buffer_factory {
+
+			public:
+
+				~_orbit_buffer_factory(void);
+
+				static _orbit_buffer_factory *acquire(void);
+
+				orbit_buffer_block_ptr allocate(
+					__in size_t length
+					);
+
+				void initialize(void);
+
+				static bool is_allocated(void);
+
+				bool is_initialized(void);
+
+				void release(
+					__in orbit_buffer_block_ptr block
+					);
+
+				size_t size(
+					__in orbit_buffer_class_t type
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				_orbit_buffer_factory(void);
+
+				_orbit_buffer_factory(
+					__in const _orbit_buffer_factory &other
+					);
+
+				_orbit_buffer_factory &operator=(
+					__in const _orbit_buffer_factory &other
+					);
+
+				static void _delete(void);
+
+				std::atomic<bool> m_initialized;
+
+				static _orbit_buffer_factory *m_instance;
+
+				std::vector<orbit_buffer_block_ptr> m_pool[ORBIT_BUFFER_CLASS_MAX];
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_buffer_factory, *orbit_buffer_factory_ptr;
+	}
+}
+
+#endif // ORBIT_BUFFER_H_
@@ -0,0 +1,72 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_BUFFER_TYPE_H_
+#define ORBIT_BUFFER_TYPE_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define ORBIT_BUFFER_HEADER "(BUFFER)"
+
+		#ifndef NDEBUG
+		#define ORBIT_BUFFER_EXCEPTION_HEADER ORBIT_BUFFER_HEADER
+		#else
+		#define ORBIT_BUFFER_EXCEPTION_HEADER EXCEPTION_HEADER
+		#endif // NDEBUG
+
+		enum {
+			ORBIT_BUFFER_EXCEPTION_ALLOCATION = 0,
+			ORBIT_BUFFER_EXCEPTION_CAPACITY,
+			ORBIT_BUFFER_EXCEPTION_EMPTY,
+			ORBIT_BUFFER_EXCEPTION_INITIALIZE,
+			ORBIT_BUFFER_EXCEPTION_TYPE,
+			ORBIT_BUFFER_EXCEPTION_UNINITIALIZE,
+		};
+
+		#define ORBIT_BUFFER_EXCEPTION_MAX ORBIT_BUFFER_EXCEPTION_UNINITIALIZE
+
+		static const std::string ORBIT_BUFFER_EXCEPTION_STR[] = {
+			ORBIT_BUFFER_EXCEPTION_HEADER " Failed to allocate buffer component",
+			ORBIT_BUFFER_EXCEPTION_HEADER " Buffer length exceeds capacity",
+			ORBIT_BUFFER_EXCEPTION_HEADER " Buffer is empty",
+			ORBIT_BUFFER_EXCEPTION_HEADER " Buffer component is initialized",
+			ORBIT_BUFFER_EXCEPTION_HEADER " Invalid buffer class",
+			ORBIT_BUFFER_EXCEPTION_HEADER " Buffer component is uninitialized",
+			};
+
+		#define ORBIT_BUFFER_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_BUFFER_EXCEPTION_MAX ? UNKNOWN_EXCEPTION : \
+			CHECK_STR(ORBIT_BUFFER_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_ORBIT_BUFFER_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(ORBIT_BUFFER_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_ORBIT_BUFFER_EXCEPTION_MESSAGE(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_MESSAGE(ORBIT_BUFFER_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+
+		class _orbit_buffer;
+		typedef _orbit_buffer orbit_buffer, *orbit_buffer_ptr;
+
+		class _orbit_buffer_factory;
+		typedef _orbit_buffer_factory orbit_buffer_factory, *orbit_buffer_factory_ptr;
+	}
+}
+
+#endif // ORBIT_BUFFER_TYPE_H_
@@ -20,12 +20,15 @@
 #ifndef ORBIT_DEFINES_H_
 #define ORBIT_DEFINES_H_
 
+#include <condition_variable>
 #include <cstdint>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace ORBIT {
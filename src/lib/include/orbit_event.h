@@ -0,0 +1,220 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_EVENT_H_
+#define ORBIT_EVENT_H_
+
+#include <functional>
+#include <map>
+#include <sys/epoll.h>
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		typedef enum {
+			ORBIT_EVENT_NONE = 0,
+			ORBIT_EVENT_READ = EPOLLIN,
+			ORBIT_EVENT_WRITE = EPOLLOUT,
+			ORBIT_EVENT_ERROR = EPOLLERR,
+			ORBIT_EVENT_HANGUP = EPOLLRDHUP,
+		} orbit_event_t;
+
+		typedef uint64_t orbit_timer_t;
+
+		#define TIMER_INVALID INVALID_TYPE(orbit_timer_t)
+
+		#define EVENT_WHEEL_BITS 8
+		#define EVENT_WHEEL_LEN (1 << EVENT_WHEEL_BITS)
+		#define EVENT_WHEEL_LEVEL 4
+
+		typedef std::function<void(int, uint32_t)> orbit_event_cb;
+
+		typedef std::function<void(void)> orbit_event_post_cb;
+
+		typedef std::function<void(orbit_timer_t)> orbit_timer_cb;
+
+		typedef struct _orbit_event_timer {
+			orbit_timer_cb callback;
+			uint64_t deadline;
+			bool expired;
+			uint32_t generation;
+			uint32_t next;
+			uint32_t previous;
+			uint32_t wheel;
+		} orbit_event_timer, *orbit_event_timer_ptr;
+
+		typedef class _orbit_event {
+
+			public:
+
+				_orbit_event(void);
+
+				~_orbit_event(void);
+
+				void add(
+					__in int descriptor,
+					__in uint32_t events,
+					__in const orbit_event_cb &callback
+					);
+
+				int close(
+					__in int descriptor
+					);
+
+				bool contains(
+					__in int descriptor
+					);
+
+				bool dispatch(
+					__in int descriptor,
+					__in uint32_t events
+					);
+
+				void initialize(void);
+
+				bool is_initialized(void);
+
+				bool is_running(void);
+
+				void modify(
+					__in int descriptor,
+					__in uint32_t events
+					);
+
+				size_t poll(
+					__in_opt int timeout = -1
+					);
+
+				void post(
+					__in const orbit_event_post_cb &callback
+					);
+
+				void remove(
+					__in int descriptor
+					);
+
+				void run(void);
+
+				size_t size(void);
+
+				void stop(void);
+
+				orbit_timer_t timer_add(
+					__in uint32_t timeout,
+					__in const orbit_timer_cb &callback
+					);
+
+				bool timer_contains(
+					__in orbit_timer_t timer
+					);
+
+				void timer_remove(
+					__in orbit_timer_t timer
+					);
+
+				void timer_reset(
+					__in orbit_timer_t timer,
+					__in uint32_t timeout
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+				void wake(void);
+
+			protected:
+
+				_orbit_event(
+					__in const _orbit_event &other
+					);
+
+				_orbit_event &operator=(
+					__in const _orbit_event &other
+					);
+
+				void descriptor_close(void);
+
+				void timer_advance(
+					__in uint64_t now,
+					__out std::vector<orbit_timer_t> &expired
+					);
+
+				void timer_arm(void);
+
+				void timer_cascade(
+					__in size_t level
+					);
+
+				size_t timer_dispatch(void);
+
+				uint32_t timer_find(
+					__in orbit_timer_t timer
+					);
+
+				void timer_insert(
+					__in uint32_t index
+					);
+
+				void timer_release(
+					__in uint32_t index
+					);
+
+				void timer_unlink(
+					__in uint32_t index
+					);
+
+				int m_descriptor_epoll;
+
+				int m_descriptor_timer;
+
+				int m_descriptor_wake;
+
+				bool m_initialized;
+
+				std::map<int, std::pair<uint32_t, orbit_event_cb>> m_map_descriptor;
+
+				std::vector<orbit_event_post_cb> m_post;
+
+				bool m_running;
+
+				std::vector<orbit_event_timer> m_timer;
+
+				std::vector<uint32_t> m_timer_free;
+
+				uint32_t m_wheel[EVENT_WHEEL_LEVEL][EVENT_WHEEL_LEN];
+
+				uint64_t m_wheel_armed;
+
+				size_t m_wheel_count[EVENT_WHEEL_LEVEL];
+
+				uint64_t m_wheel_time;
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_event, *orbit_event_ptr;
+	}
+}
+
+#endif // ORBIT_EVENT_H_
@@ -0,0 +1,67 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_EVENT_TYPE_H_
+#define ORBIT_EVENT_TYPE_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define ORBIT_EVENT_HEADER "(EVENT)"
+
+		#ifndef NDEBUG
+		#define ORBIT_EVENT_EXCEPTION_HEADER ORBIT_EVENT_HEADER
+		#else
+		#define ORBIT_EVENT_EXCEPTION_HEADER EXCEPTION_HEADER
+		#endif // NDEBUG
+
+		enum {
+			ORBIT_EVENT_EXCEPTION_INITIALIZE = 0,
+			ORBIT_EVENT_EXCEPTION_INTERNAL,
+			ORBIT_EVENT_EXCEPTION_NOT_FOUND,
+			ORBIT_EVENT_EXCEPTION_TIMER_NOT_FOUND,
+			ORBIT_EVENT_EXCEPTION_UNINITIALIZE,
+		};
+
+		#define ORBIT_EVENT_EXCEPTION_MAX ORBIT_EVENT_EXCEPTION_UNINITIALIZE
+
+		static const std::string ORBIT_EVENT_EXCEPTION_STR[] = {
+			ORBIT_EVENT_EXCEPTION_HEADER " Event component is initialized",
+			ORBIT_EVENT_EXCEPTION_HEADER " Internal event exception",
+			ORBIT_EVENT_EXCEPTION_HEADER " Event component entry does not exist",
+			ORBIT_EVENT_EXCEPTION_HEADER " Event component timer does not exist",
+			ORBIT_EVENT_EXCEPTION_HEADER " Event component is uninitialized",
+			};
+
+		#define ORBIT_EVENT_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_EVENT_EXCEPTION_MAX ? UNKNOWN_EXCEPTION : \
+			CHECK_STR(ORBIT_EVENT_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_ORBIT_EVENT_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(ORBIT_EVENT_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+
+		class _orbit_event;
+		typedef _orbit_event orbit_event, *orbit_event_ptr;
+	}
+}
+
+#endif // ORBIT_EVENT_TYPE_H_
@@ -0,0 +1,127 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_RATE_H_
+#define ORBIT_RATE_H_
+
+#include <atomic>
+#include <set>
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define RATE_UNLIMITED 0
+
+		typedef class _orbit_rate {
+
+			public:
+
+				_orbit_rate(
+					__in_opt uint64_t rate = RATE_UNLIMITED,
+					__in_opt _orbit_rate *parent = NULL
+					);
+
+				~_orbit_rate(void);
+
+				size_t acquire(
+					__in size_t length
+					);
+
+				uint64_t burst(void);
+
+				uint32_t delay(void);
+
+				bool is_limited(void);
+
+				_orbit_rate *parent(void);
+
+				uint64_t rate(void);
+
+				void release(
+					__in size_t length
+					);
+
+				void set_parent(
+					__in_opt _orbit_rate *parent = NULL
+					);
+
+				void set_rate(
+					__in uint64_t rate,
+					__in_opt uint64_t burst = 0
+					);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				uint64_t total(void);
+
+			protected:
+
+				_orbit_rate(
+					__in const _orbit_rate &other
+					);
+
+				_orbit_rate &operator=(
+					__in const _orbit_rate &other
+					);
+
+				size_t quota(
+					__in const _orbit_rate *child,
+					__in size_t length
+					);
+
+				void refill(void);
+
+				void refund(
+					__in size_t length
+					);
+
+				void take(
+					__in size_t length
+					);
+
+				uint32_t wait(void);
+
+				std::set<const _orbit_rate *> m_active;
+
+				size_t m_active_last;
+
+				uint64_t m_burst;
+
+				std::atomic<_orbit_rate *> m_parent;
+
+				std::atomic<uint64_t> m_rate;
+
+				uint64_t m_time;
+
+				int64_t m_tokens;
+
+				std::atomic<uint64_t> m_total;
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_rate, *orbit_rate_ptr;
+	}
+}
+
+#endif // ORBIT_RATE_H_
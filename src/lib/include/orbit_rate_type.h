@@ -0,0 +1,59 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_RATE_TYPE_H_
+#define ORBIT_RATE_TYPE_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define ORBIT_RATE_HEADER "(RATE)"
+
+		#ifndef NDEBUG
+		#define ORBIT_RATE_EXCEPTION_HEADER ORBIT_RATE_HEADER
+		#else
+		#define ORBIT_RATE_EXCEPTION_HEADER EXCEPTION_HEADER
+		#endif // NDEBUG
+
+		enum {
+			ORBIT_RATE_EXCEPTION_PARENT = 0,
+		};
+
+		#define ORBIT_RATE_EXCEPTION_MAX ORBIT_RATE_EXCEPTION_PARENT
+
+		static const std::string ORBIT_RATE_EXCEPTION_STR[] = {
+			ORBIT_RATE_EXCEPTION_HEADER " Invalid rate parent",
+			};
+
+		#define ORBIT_RATE_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_RATE_EXCEPTION_MAX ? UNKNOWN_EXCEPTION : \
+			CHECK_STR(ORBIT_RATE_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_ORBIT_RATE_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(ORBIT_RATE_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_ORBIT_RATE_EXCEPTION_MESSAGE(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_MESSAGE(ORBIT_RATE_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+
+		class _orbit_rate;
+		typedef _orbit_rate orbit_rate, *orbit_rate_ptr;
+	}
+}
+
+#endif // ORBIT_RATE_TYPE_H_
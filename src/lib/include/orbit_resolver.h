@@ -0,0 +1,129 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_RESOLVER_H_
+#define ORBIT_RESOLVER_H_
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <sys/socket.h>
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		typedef std::vector<sockaddr_storage> orbit_resolver_address_t;
+
+		typedef std::function<void(const std::string &, int, const orbit_resolver_address_t &)> orbit_resolver_cb;
+
+		typedef class _orbit_resolver {
+
+			public:
+
+				~_orbit_resolver(void);
+
+				static _orbit_resolver *acquire(void);
+
+				void clear(void);
+
+				bool contains(
+					__in const std::string &host
+					);
+
+				void initialize(void);
+
+				static bool is_allocated(void);
+
+				bool is_initialized(void);
+
+				bool lookup(
+					__in const std::string &host,
+					__out orbit_resolver_address_t &address
+					);
+
+				orbit_resolver_address_t resolve(
+					__in const std::string &host
+					);
+
+				orbit_resolver_address_t resolve(
+					__in const std::string &host,
+					__out int &error
+					);
+
+				void resolve(
+					__in const std::string &host,
+					__in const orbit_resolver_cb &complete
+					);
+
+				void set_ttl(
+					__in uint32_t ttl
+					);
+
+				size_t size(void);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				uint32_t ttl(void);
+
+				void uninitialize(void);
+
+			protected:
+
+				_orbit_resolver(void);
+
+				_orbit_resolver(
+					__in const _orbit_resolver &other
+					);
+
+				_orbit_resolver &operator=(
+					__in const _orbit_resolver &other
+					);
+
+				static void _delete(void);
+
+				void worker(void);
+
+				std::condition_variable_any m_condition;
+
+				bool m_initialized;
+
+				static _orbit_resolver *m_instance;
+
+				std::map<std::string, std::pair<uint64_t, orbit_resolver_address_t>> m_map_cache;
+
+				std::map<std::string, std::vector<orbit_resolver_cb>> m_map_pending;
+
+				std::deque<std::string> m_queue;
+
+				uint32_t m_ttl;
+
+				std::vector<std::thread> m_worker;
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_resolver, *orbit_resolver_ptr;
+	}
+}
+
+#endif // ORBIT_RESOLVER_H_
@@ -0,0 +1,65 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_RESOLVER_TYPE_H_
+#define ORBIT_RESOLVER_TYPE_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define ORBIT_RESOLVER_HEADER "(RESOLVER)"
+
+		#ifndef NDEBUG
+		#define ORBIT_RESOLVER_EXCEPTION_HEADER ORBIT_RESOLVER_HEADER
+		#else
+		#define ORBIT_RESOLVER_EXCEPTION_HEADER EXCEPTION_HEADER
+		#endif // NDEBUG
+
+		enum {
+			ORBIT_RESOLVER_EXCEPTION_ALLOCATION = 0,
+			ORBIT_RESOLVER_EXCEPTION_INITIALIZE,
+			ORBIT_RESOLVER_EXCEPTION_INTERNAL,
+			ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE,
+		};
+
+		#define ORBIT_RESOLVER_EXCEPTION_MAX ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE
+
+		static const std::string ORBIT_RESOLVER_EXCEPTION_STR[] = {
+			ORBIT_RESOLVER_EXCEPTION_HEADER " Failed to allocate resolver component",
+			ORBIT_RESOLVER_EXCEPTION_HEADER " Resolver component is initialized",
+			ORBIT_RESOLVER_EXCEPTION_HEADER " Internal resolver exception",
+			ORBIT_RESOLVER_EXCEPTION_HEADER " Resolver component is uninitialized",
+			};
+
+		#define ORBIT_RESOLVER_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_RESOLVER_EXCEPTION_MAX ? UNKNOWN_EXCEPTION : \
+			CHECK_STR(ORBIT_RESOLVER_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_ORBIT_RESOLVER_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_ORBIT_RESOLVER_EXCEPTION_MESSAGE(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_MESSAGE(ORBIT_RESOLVER_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+
+		class _orbit_resolver;
+		typedef _orbit_resolver orbit_resolver, *orbit_resolver_ptr;
+	}
+}
+
+#endif // ORBIT_RESOLVER_TYPE_H_
@@ -0,0 +1,101 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_RING_H_
+#define ORBIT_RING_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		typedef class _orbit_ring {
+
+			public:
+
+				_orbit_ring(void);
+
+				_orbit_ring(
+					__in _orbit_ring &&other
+					) noexcept;
+
+				~_orbit_ring(void);
+
+				_orbit_ring &operator=(
+					__in _orbit_ring &&other
+					) noexcept;
+
+				size_t capacity(void);
+
+				void clear(void);
+
+				void commit(
+					__in size_t length
+					);
+
+				void consume(
+					__in size_t length
+					);
+
+				void initialize(
+					__in size_t capacity
+					);
+
+				bool is_initialized(void);
+
+				size_t length(void);
+
+				const uint8_t *peek(void);
+
+				uint8_t *reserve(void);
+
+				size_t space(void);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				_orbit_ring(
+					__in const _orbit_ring &other
+					);
+
+				_orbit_ring &operator=(
+					__in const _orbit_ring &other
+					);
+
+				uint8_t *m_base;
+
+				size_t m_capacity;
+
+				uint64_t m_head;
+
+				uint64_t m_tail;
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_ring, *orbit_ring_ptr;
+	}
+}
+
+#endif // ORBIT_RING_H_
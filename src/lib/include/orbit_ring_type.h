@@ -0,0 +1,67 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_RING_TYPE_H_
+#define ORBIT_RING_TYPE_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define ORBIT_RING_HEADER "(RING)"
+
+		#ifndef NDEBUG
+		#define ORBIT_RING_EXCEPTION_HEADER ORBIT_RING_HEADER
+		#else
+		#define ORBIT_RING_EXCEPTION_HEADER EXCEPTION_HEADER
+		#endif // NDEBUG
+
+		enum {
+			ORBIT_RING_EXCEPTION_CAPACITY = 0,
+			ORBIT_RING_EXCEPTION_INITIALIZE,
+			ORBIT_RING_EXCEPTION_INTERNAL,
+			ORBIT_RING_EXCEPTION_LENGTH,
+			ORBIT_RING_EXCEPTION_UNINITIALIZE,
+		};
+
+		#define ORBIT_RING_EXCEPTION_MAX ORBIT_RING_EXCEPTION_UNINITIALIZE
+
+		static const std::string ORBIT_RING_EXCEPTION_STR[] = {
+			ORBIT_RING_EXCEPTION_HEADER " Invalid ring capacity",
+			ORBIT_RING_EXCEPTION_HEADER " Ring component is initialized",
+			ORBIT_RING_EXCEPTION_HEADER " Internal ring exception",
+			ORBIT_RING_EXCEPTION_HEADER " Ring length exceeds available data",
+			ORBIT_RING_EXCEPTION_HEADER " Ring component is uninitialized",
+			};
+
+		#define ORBIT_RING_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_RING_EXCEPTION_MAX ? UNKNOWN_EXCEPTION : \
+			CHECK_STR(ORBIT_RING_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_ORBIT_RING_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(ORBIT_RING_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_ORBIT_RING_EXCEPTION_MESSAGE(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+
+		class _orbit_ring;
+		typedef _orbit_ring orbit_ring, *orbit_ring_ptr;
+	}
+}
+
+#endif // ORBIT_RING_TYPE_H_
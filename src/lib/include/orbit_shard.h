@@ -0,0 +1,149 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_SHARD_H_
+#define ORBIT_SHARD_H_
+
+#include <atomic>
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		typedef std::function<void(void)> orbit_shard_cb;
+
+		typedef struct _orbit_shard_node {
+			std::atomic<struct _orbit_shard_node *> next;
+			orbit_shard_cb callback;
+		} orbit_shard_node, *orbit_shard_node_ptr;
+
+		typedef class _orbit_shard {
+
+			public:
+
+				_orbit_shard(
+					__in size_t index,
+					__in uint32_t range,
+					__in int core
+					);
+
+				~_orbit_shard(void);
+
+				orbit_uid accept(
+					__in const orbit_uid &uid
+					);
+
+				orbit_socket_factory_ptr acquire_factory(void);
+
+				int core(void);
+
+				orbit_event &event(void);
+
+				size_t failed(void);
+
+				std::vector<orbit_uid> generate_listen(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in_opt size_t count = 1,
+					__in_opt int backlog = SOMAXCONN
+					);
+
+				orbit_uid generate_tcp(
+					__in_opt const std::string &host = std::string(),
+					__in_opt uint16_t port = 0
+					);
+
+				orbit_uid generate_udp(
+					__in_opt const std::string &host = std::string(),
+					__in_opt uint16_t port = 0
+					);
+
+				size_t index(void);
+
+				void initialize(void);
+
+				bool is_current(void);
+
+				bool is_initialized(void);
+
+				void post(
+					__in const orbit_shard_cb &callback
+					);
+
+				uint32_t range(void);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				_orbit_shard(
+					__in const _orbit_shard &other
+					);
+
+				_orbit_shard &operator=(
+					__in const _orbit_shard &other
+					);
+
+				void drain(void);
+
+				std::vector<orbit_uid> generate(
+					__in const std::function<std::vector<orbit_uid>(void)> &create
+					);
+
+				bool pop(
+					__out orbit_shard_cb &callback
+					);
+
+				void run(void);
+
+				int m_core;
+
+				int m_descriptor_queue;
+
+				orbit_socket_factory_ptr m_factory;
+
+				std::atomic<size_t> m_failed;
+
+				size_t m_index;
+
+				std::atomic<bool> m_initialized;
+
+				std::atomic<orbit_shard_node_ptr> m_queue_head;
+
+				orbit_shard_node_ptr m_queue_tail;
+
+				uint32_t m_range;
+
+				std::atomic<bool> m_signalled;
+
+				std::thread m_thread;
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_shard, *orbit_shard_ptr;
+	}
+}
+
+#endif // ORBIT_SHARD_H_
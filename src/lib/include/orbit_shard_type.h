@@ -0,0 +1,63 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_SHARD_TYPE_H_
+#define ORBIT_SHARD_TYPE_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define ORBIT_SHARD_HEADER "(SHARD)"
+
+		#ifndef NDEBUG
+		#define ORBIT_SHARD_EXCEPTION_HEADER ORBIT_SHARD_HEADER
+		#else
+		#define ORBIT_SHARD_EXCEPTION_HEADER EXCEPTION_HEADER
+		#endif // NDEBUG
+
+		enum {
+			ORBIT_SHARD_EXCEPTION_INITIALIZE = 0,
+			ORBIT_SHARD_EXCEPTION_INTERNAL,
+			ORBIT_SHARD_EXCEPTION_UNINITIALIZE,
+		};
+
+		#define ORBIT_SHARD_EXCEPTION_MAX ORBIT_SHARD_EXCEPTION_UNINITIALIZE
+
+		static const std::string ORBIT_SHARD_EXCEPTION_STR[] = {
+			ORBIT_SHARD_EXCEPTION_HEADER " Shard component is initialized",
+			ORBIT_SHARD_EXCEPTION_HEADER " Internal shard exception",
+			ORBIT_SHARD_EXCEPTION_HEADER " Shard component is uninitialized",
+			};
+
+		#define ORBIT_SHARD_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_SHARD_EXCEPTION_MAX ? UNKNOWN_EXCEPTION : \
+			CHECK_STR(ORBIT_SHARD_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_ORBIT_SHARD_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(ORBIT_SHARD_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_ORBIT_SHARD_EXCEPTION_MESSAGE(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_MESSAGE(ORBIT_SHARD_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+
+		class _orbit_shard;
+		typedef _orbit_shard orbit_shard, *orbit_shard_ptr;
+	}
+}
+
+#endif // ORBIT_SHARD_TYPE_H_
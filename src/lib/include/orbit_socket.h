@@ -21,7 +21,11 @@
 #define ORBIT_SOCKET_H_
 
 #include <map>
+#include <memory>
 #include <netdb.h>
+#include <unordered_map>
+#include <sys/socket.h>
+#include <sys/uio.h>
 
 namespace ORBIT {
 
@@ -43,8 +47,35 @@ namespace ORBIT {
 
 		#define ORBIT_SOCKET_FAMILY_TYPE_MAX ORBIT_SOCKET_FAMILY_TYPE_IPV6
 
+		#define SOCKET_AGAIN INVALID_TYPE(int)
+		#define SOCKET_ERROR (-2)
+		#define SOCKET_RING_LEN 0x20000
+		#define SOCKET_SHARD_COUNT 0x10
+		#define SOCKET_ZEROCOPY_LEN 0x4000
+
+		typedef struct _orbit_socket_datagram {
+			sockaddr_storage address;
+			socklen_t length;
+			orbit_buf_t data;
+			bool truncated;
+		} orbit_socket_datagram, *orbit_socket_datagram_ptr;
+
+		typedef std::function<void(const orbit_uid &, int)> orbit_socket_connect_cb;
+
+		class _orbit_socket;
+
+		typedef struct _orbit_socket_owner {
+			std::weak_ptr<_orbit_socket> handle;
+			std::mutex lock;
+			bool pinned;
+			_orbit_socket *socket;
+		} orbit_socket_owner, *orbit_socket_owner_ptr;
+
+		typedef std::function<void(const orbit_uid &, uint32_t)> orbit_socket_event_cb;
+
 		typedef class _orbit_socket :
-				public orbit_uid_class {
+				public orbit_uid_class,
+				public std::enable_shared_from_this<_orbit_socket> {
 
 			public:
 
@@ -54,23 +85,51 @@ namespace ORBIT {
 					);
 
 				_orbit_socket(
-					__in const _orbit_socket &other
-					);
+					__in _orbit_socket &&other
+					) noexcept;
 
 				virtual ~_orbit_socket(void);
 
 				_orbit_socket &operator=(
-					__in const _orbit_socket &other
-					);
+					__in _orbit_socket &&other
+					) noexcept;
 
 				std::string address(void);
 
+				size_t batch(void);
+
 				void close(void);
 
+				bool close(
+					__out int &error
+					);
+
+				void cork(void);
+
+				static void datagram_address(
+					__in const std::string &host,
+					__in uint16_t port,
+					__out orbit_socket_datagram &datagram
+					);
+
+				int descriptor(void);
+
 				orbit_socket_family_t family(void);
 
+				void flush(void);
+
+				bool is_blocking(void);
+
+				bool is_connecting(void);
+
+				bool is_corked(void);
+
+				bool is_listening(void);
+
 				bool is_open(void);
 
+				bool is_zerocopy(void);
+
 				void open_tcp(void);
 
 				void open_tcp(
@@ -78,16 +137,128 @@ namespace ORBIT {
 					__in uint16_t port
 					);
 
+				bool open_tcp(
+					__in const std::string &host,
+					__in uint16_t port,
+					__out int &error
+					);
+
+				void open_tcp(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in uint32_t timeout,
+					__in const orbit_socket_connect_cb &complete,
+					__in_opt orbit_event_ptr event = NULL
+					);
+
+				void open_listen(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in_opt int backlog = SOMAXCONN
+					);
+
+				void open_udp(void);
+
+				void open_udp(
+					__in const std::string &host,
+					__in uint16_t port
+					);
+
 				uint16_t port(void);
 
+				orbit_rate_ptr rate_read(void);
+
+				orbit_rate_ptr rate_write(void);
+
 				int read(
 					__in orbit_buf_t &output
 					);
 
+				int read(
+					__in orbit_buf_t &output,
+					__out int &error
+					);
+
 				int read(
 					__in std::string &output
 					);
 
+				int read_batch(
+					__inout std::vector<orbit_socket_datagram> &output
+					);
+
+				int read_exact(
+					__out uint8_t *output,
+					__in size_t length
+					);
+
+				int read_exact(
+					__out uint8_t *output,
+					__in size_t length,
+					__out int &error
+					);
+
+				int read_exact(
+					__inout orbit_buf_t &output
+					);
+
+				int read_some(
+					__out uint8_t *output,
+					__in size_t length
+					);
+
+				int read_some(
+					__out uint8_t *output,
+					__in size_t length,
+					__out int &error
+					);
+
+				int read_some(
+					__inout orbit_buf_t &output
+					);
+
+				int read_some(
+					__inout orbit_buffer &output
+					);
+
+				void ring_consume(
+					__in size_t length
+					);
+
+				void ring_disable(void);
+
+				void ring_enable(
+					__in_opt size_t capacity = SOCKET_RING_LEN
+					);
+
+				int ring_fill(void);
+
+				bool ring_frame(
+					__out const uint8_t *&frame,
+					__out size_t &length
+					);
+
+				const uint8_t *ring_peek(
+					__out size_t &length
+					);
+
+				void set_batch(
+					__in size_t batch
+					);
+
+				void set_blocking(
+					__in bool blocking
+					);
+
+				void set_rate(
+					__in_opt orbit_rate_ptr read = NULL,
+					__in_opt orbit_rate_ptr write = NULL
+					);
+
+				void set_zerocopy(
+					__in bool zerocopy
+					);
+
 				virtual std::string to_string(
 					__in_opt bool verbose = false
 					);
@@ -98,44 +269,300 @@ namespace ORBIT {
 					__in const orbit_buf_t &input
 					);
 
+				int write(
+					__in const orbit_buffer &input
+					);
+
 				int write(
 					__in const std::string &input
 					);
 
+				int write(
+					__in const uint8_t *input,
+					__in size_t length
+					);
+
+				int write(
+					__in const uint8_t *input,
+					__in size_t length,
+					__out int &error
+					);
+
+				int write(
+					__in const iovec *input,
+					__in size_t count
+					);
+
+				int write(
+					__in const iovec *input,
+					__in size_t count,
+					__out int &error
+					);
+
+				int write(
+					__in const std::vector<iovec> &input
+					);
+
+				int write_batch(
+					__in const std::vector<orbit_socket_datagram> &input
+					);
+
+				int write_file(
+					__in int descriptor,
+					__in off_t offset,
+					__in size_t length
+					);
+
+				int write_file(
+					__in int descriptor,
+					__in off_t offset,
+					__in size_t length,
+					__in const orbit_buf_t &header
+					);
+
+				size_t zerocopy_complete(void);
+
 			protected:
 
+				friend class _orbit_socket_factory;
+
+				_orbit_socket(
+					__in const _orbit_socket &other
+					) = delete;
+
+				_orbit_socket &operator=(
+					__in const _orbit_socket &other
+					) = delete;
+
+				sockaddr *address_set(
+					__in const sockaddr *address,
+					__out socklen_t &length
+					);
+
+				void connect_attempt(void);
+
+				void connect_bind(void);
+
+				void connect_cancel(void);
+
+				bool connect_candidate(
+					__in const orbit_resolver_address_t &candidate,
+					__out int &error
+					);
+
+				void connect_complete(
+					__in int descriptor,
+					__in int error
+					);
+
+				void connect_delay(
+					__in orbit_timer_t timer
+					);
+
+				void connect_event(
+					__in int descriptor,
+					__in uint32_t events
+					);
+
+				void connect_fail(
+					__in int descriptor,
+					__in int error
+					);
+
+				static std::shared_ptr<_orbit_socket> connect_owner(
+					__in const std::weak_ptr<orbit_socket_owner> &guard,
+					__out _orbit_socket *&socket
+					);
+
+				void connect_resolve(
+					__in int error,
+					__in const orbit_resolver_address_t &address
+					);
+
+				void connect_timeout(
+					__in int descriptor,
+					__in orbit_timer_t timer
+					);
+
+				void open_bind(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in orbit_socket_t type,
+					__in bool reuse,
+					__in bool blocking
+					);
+
+				bool open_descriptor(
+					__in int descriptor,
+					__in const sockaddr *peer,
+					__out int &error
+					);
+
+				void rate_cancel(void);
+
+				void rate_defer(
+					__in orbit_rate_ptr rate,
+					__in uint32_t events
+					);
+
+				size_t rate_wait(
+					__in orbit_rate_ptr rate,
+					__in size_t length,
+					__in uint32_t events
+					);
+
+				void resolve(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in orbit_socket_t type,
+					__out orbit_resolver_address_t &address
+					);
+
+				bool resolve(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in orbit_socket_t type,
+					__out orbit_resolver_address_t &address,
+					__out int &error
+					);
+
+				static int resolve_error(
+					__in int error
+					);
+
+				void swap(
+					__inout _orbit_socket &other
+					) noexcept;
+
+				int write_zerocopy(
+					__in const orbit_buffer &input
+					);
+
+				void zerocopy_wait(void);
+
 				sockaddr_in m_address_4;
 
 				sockaddr_in6 m_address_6;
 
+				size_t m_batch;
+
+				std::vector<orbit_buf_t> m_batch_buffer;
+
+				std::vector<mmsghdr> m_batch_message;
+
+				std::vector<iovec> m_batch_vector;
+
+				bool m_blocking;
+
+				orbit_resolver_address_t m_connect_candidate;
+
+				orbit_socket_connect_cb m_connect_complete;
+
+				int m_connect_error;
+
+				orbit_event_ptr m_connect_event;
+
+				std::shared_ptr<orbit_socket_owner> m_connect_guard;
+
+				size_t m_connect_next;
+
+				std::map<int, std::pair<sockaddr_storage, orbit_timer_t>> m_connect_pending;
+
+				orbit_timer_t m_connect_timer;
+
+				uint32_t m_connect_timeout;
+
+				bool m_corked;
+
 				std::string m_host;
 
-				addrinfo *m_information;
+				bool m_listening;
 
 				uint16_t m_port;
 
+				uint32_t m_rate_events;
+
+				orbit_rate_ptr m_rate_read;
+
+				orbit_timer_t m_rate_timer;
+
+				orbit_rate_ptr m_rate_write;
+
+				orbit_ring m_ring;
+
 				int m_socket;
 
 				orbit_socket_t m_type;
 
+				orbit_event_ptr m_watch;
+
+				bool m_zerocopy;
+
+				uint32_t m_zerocopy_next;
+
+				std::map<uint32_t, orbit_buffer> m_zerocopy_pending;
+
 			private:
 
 				std::recursive_mutex m_lock;
 
 		} orbit_socket, *orbit_socket_ptr;
 
+		typedef std::shared_ptr<orbit_socket> orbit_socket_handle;
+
+		typedef std::pair<std::string, uint16_t> orbit_socket_endpoint;
+
+		typedef std::function<void(size_t, const orbit_uid &, int)> orbit_socket_bulk_cb;
+
+		typedef struct _orbit_socket_bulk {
+			size_t active;
+			orbit_socket_bulk_cb complete;
+			size_t concurrency;
+			std::vector<orbit_socket_endpoint> endpoint;
+			orbit_event_ptr event;
+			bool launching;
+			std::recursive_mutex lock;
+			size_t next;
+			uint32_t timeout;
+		} orbit_socket_bulk, *orbit_socket_bulk_ptr;
+
+		typedef std::unordered_map<orbit_uid, std::pair<orbit_socket_handle, size_t>> orbit_socket_shard_map;
+
+		typedef struct _orbit_socket_shard {
+			std::mutex lock;
+			orbit_socket_shard_map map;
+		} orbit_socket_shard, *orbit_socket_shard_ptr;
+
 		typedef class _orbit_socket_factory {
 
 			public:
 
 				~_orbit_socket_factory(void);
 
+				orbit_uid accept(
+					__in const orbit_uid &uid
+					);
+
 				static _orbit_socket_factory *acquire(void);
 
-				orbit_socket &at(
+				orbit_event_ptr acquire_event(void);
+
+				orbit_rate_ptr acquire_rate_read(void);
+
+				orbit_rate_ptr acquire_rate_write(void);
+
+				orbit_socket_handle at(
 					__in const orbit_uid &uid
 					);
 
+				void connect_tcp(
+					__in const std::vector<orbit_socket_endpoint> &endpoint,
+					__in size_t concurrency,
+					__in uint32_t timeout,
+					__in const orbit_socket_bulk_cb &complete,
+					__in_opt orbit_event_ptr event = NULL
+					);
+
 				bool contains(
 					__in const orbit_uid &uid
 					);
@@ -144,11 +571,32 @@ namespace ORBIT {
 					__in const orbit_uid &uid
 					);
 
+				std::vector<orbit_uid> generate_listen(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in_opt size_t count = 1,
+					__in_opt int backlog = SOMAXCONN
+					);
+
 				orbit_uid generate_tcp(
 					__in_opt const std::string &host = std::string(),
 					__in_opt uint16_t port = 0
 					);
 
+				orbit_uid generate_udp(
+					__in_opt const std::string &host = std::string(),
+					__in_opt uint16_t port = 0
+					);
+
+				orbit_socket_handle handle(
+					__in const orbit_uid &uid
+					);
+
+				orbit_socket_handle handle(
+					__in const orbit_uid &uid,
+					__out int &error
+					);
+
 				size_t increment_reference(
 					__in const orbit_uid &uid
 					);
@@ -159,10 +607,19 @@ namespace ORBIT {
 
 				bool is_initialized(void);
 
+				size_t poll(
+					__in_opt int timeout = -1
+					);
+
 				size_t reference_count(
 					__in const orbit_uid &uid
 					);
 
+				size_t reference_count(
+					__in const orbit_uid &uid,
+					__out int &error
+					);
+
 				size_t size(void);
 
 				std::string to_string(
@@ -171,8 +628,20 @@ namespace ORBIT {
 
 				void uninitialize(void);
 
+				void unwatch(
+					__in const orbit_uid &uid
+					);
+
+				void watch(
+					__in const orbit_uid &uid,
+					__in uint32_t events,
+					__in const orbit_socket_event_cb &callback
+					);
+
 			protected:
 
+				friend class _orbit_shard;
+
 				_orbit_socket_factory(void);
 
 				_orbit_socket_factory(
@@ -185,15 +654,40 @@ namespace ORBIT {
 
 				static void _delete(void);
 
-				std::map<orbit_uid, std::pair<orbit_socket, size_t>>::iterator find(
+				void connect_launch(
+					__in const std::shared_ptr<orbit_socket_bulk> &state
+					);
+
+				void connect_result(
+					__in const std::shared_ptr<orbit_socket_bulk> &state,
+					__in size_t index,
+					__in const orbit_uid &uid,
+					__in int error
+					);
+
+				orbit_uid generate(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in orbit_socket_t type
+					);
+
+				orbit_socket_shard &shard(
 					__in const orbit_uid &uid
 					);
 
-				bool m_initialized;
+				orbit_event m_event;
+
+				std::shared_ptr<bool> m_guard;
+
+				std::atomic<bool> m_initialized;
 
 				static _orbit_socket_factory *m_instance;
 
-				std::map<orbit_uid, std::pair<orbit_socket, size_t>> m_map_socket;
+				orbit_rate m_rate_read;
+
+				orbit_rate m_rate_write;
+
+				orbit_socket_shard m_shard[SOCKET_SHARD_COUNT];
 
 			private:
 
@@ -34,11 +34,18 @@ namespace ORBIT {
 
 		enum {
 			ORBIT_SOCKET_EXCEPTION_ALLOCATION = 0,
+			ORBIT_SOCKET_EXCEPTION_BATCH,
 			ORBIT_SOCKET_EXCEPTION_CLOSE,
+			ORBIT_SOCKET_EXCEPTION_CONCURRENCY,
+			ORBIT_SOCKET_EXCEPTION_FILE,
 			ORBIT_SOCKET_EXCEPTION_INITIALIZE,
 			ORBIT_SOCKET_EXCEPTION_INTERNAL,
 			ORBIT_SOCKET_EXCEPTION_NOT_FOUND,
 			ORBIT_SOCKET_EXCEPTION_OPEN,
+			ORBIT_SOCKET_EXCEPTION_RING,
+			ORBIT_SOCKET_EXCEPTION_RING_FRAME,
+			ORBIT_SOCKET_EXCEPTION_SHUTDOWN,
+			ORBIT_SOCKET_EXCEPTION_TYPE,
 			ORBIT_SOCKET_EXCEPTION_TYPE_INET,
 			ORBIT_SOCKET_EXCEPTION_UNINITIALIZE,
 		};
@@ -47,11 +54,18 @@ namespace ORBIT {
 
 		static const std::string ORBIT_SOCKET_EXCEPTION_STR[] = {
 			ORBIT_SOCKET_EXCEPTION_HEADER " Failed to allocate socket component",
+			ORBIT_SOCKET_EXCEPTION_HEADER " Invalid socket batch length",
 			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component is closed",
+			ORBIT_SOCKET_EXCEPTION_HEADER " Invalid socket connect concurrency",
+			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component file range exceeds file length",
 			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component is initialized",
 			ORBIT_SOCKET_EXCEPTION_HEADER " Internal socket exception",
 			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component entry does not exist",
 			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component is open",
+			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component receive ring is disabled",
+			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component ring frame exceeds capacity",
+			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component peer closed connection",
+			ORBIT_SOCKET_EXCEPTION_HEADER " Invalid socket type",
 			ORBIT_SOCKET_EXCEPTION_HEADER " Invalid socket INET type",
 			ORBIT_SOCKET_EXCEPTION_HEADER " Socket component is uninitialized",
 			};
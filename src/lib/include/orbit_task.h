@@ -0,0 +1,143 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_TASK_H_
+#define ORBIT_TASK_H_
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <type_traits>
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		typedef std::function<void(void)> orbit_task_cb;
+
+		typedef struct _orbit_task_worker {
+			std::deque<orbit_task_cb> entry;
+			std::mutex lock;
+			std::thread thread;
+		} orbit_task_worker, *orbit_task_worker_ptr;
+
+		typedef class _orbit_task {
+
+			public:
+
+				~_orbit_task(void);
+
+				static _orbit_task *acquire(void);
+
+				size_t failed(void);
+
+				void initialize(
+					__in_opt size_t workers = 0
+					);
+
+				static bool is_allocated(void);
+
+				bool is_initialized(void);
+
+				size_t pending(void);
+
+				size_t size(void);
+
+				template<typename _FUNC_> 
+				std::future<typename std::result_of<_FUNC_()>::type> submit(
+					__in _FUNC_ &&function
+					)
+				{
+					typedef typename std::result_of<_FUNC_()>::type result_t;
+
+					std::shared_ptr<std::packaged_task<result_t()>> task = 
+						std::make_shared<std::packaged_task<result_t()>>(std::forward<_FUNC_>(function));
+					std::future<result_t> result = task->get_future();
+
+					enqueue([task](void) {
+							(*task)();
+						});
+
+					return result;
+				}
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				_orbit_task(void);
+
+				_orbit_task(
+					__in const _orbit_task &other
+					);
+
+				_orbit_task &operator=(
+					__in const _orbit_task &other
+					);
+
+				static void _delete(void);
+
+				void enqueue(
+					__in const orbit_task_cb &callback
+					);
+
+				void run(
+					__in size_t index
+					);
+
+				bool take(
+					__in size_t index,
+					__out orbit_task_cb &callback
+					);
+
+				std::atomic<size_t> m_failed;
+
+				std::atomic<size_t> m_idle;
+
+				std::atomic<bool> m_initialized;
+
+				static _orbit_task *m_instance;
+
+				std::atomic<size_t> m_next;
+
+				std::atomic<size_t> m_pending;
+
+				std::atomic<bool> m_running;
+
+				std::atomic<size_t> m_submit;
+
+				std::condition_variable m_wait;
+
+				std::mutex m_wait_lock;
+
+				std::vector<orbit_task_worker_ptr> m_worker;
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_task, *orbit_task_ptr;
+	}
+}
+
+#endif // ORBIT_TASK_H_
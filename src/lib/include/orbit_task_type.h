@@ -0,0 +1,63 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_TASK_TYPE_H_
+#define ORBIT_TASK_TYPE_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define ORBIT_TASK_HEADER "(TASK)"
+
+		#ifndef NDEBUG
+		#define ORBIT_TASK_EXCEPTION_HEADER ORBIT_TASK_HEADER
+		#else
+		#define ORBIT_TASK_EXCEPTION_HEADER EXCEPTION_HEADER
+		#endif // NDEBUG
+
+		enum {
+			ORBIT_TASK_EXCEPTION_ALLOCATION = 0,
+			ORBIT_TASK_EXCEPTION_INITIALIZE,
+			ORBIT_TASK_EXCEPTION_UNINITIALIZE,
+		};
+
+		#define ORBIT_TASK_EXCEPTION_MAX ORBIT_TASK_EXCEPTION_UNINITIALIZE
+
+		static const std::string ORBIT_TASK_EXCEPTION_STR[] = {
+			ORBIT_TASK_EXCEPTION_HEADER " Failed to allocate task component",
+			ORBIT_TASK_EXCEPTION_HEADER " Task component is initialized",
+			ORBIT_TASK_EXCEPTION_HEADER " Task component is uninitialized",
+			};
+
+		#define ORBIT_TASK_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_TASK_EXCEPTION_MAX ? UNKNOWN_EXCEPTION : \
+			CHECK_STR(ORBIT_TASK_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_ORBIT_TASK_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(ORBIT_TASK_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_ORBIT_TASK_EXCEPTION_MESSAGE(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_MESSAGE(ORBIT_TASK_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+
+		class _orbit_task;
+		typedef _orbit_task orbit_task, *orbit_task_ptr;
+	}
+}
+
+#endif // ORBIT_TASK_TYPE_H_
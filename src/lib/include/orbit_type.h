@@ -33,6 +33,7 @@ namespace ORBIT {
 	enum {
 		ORBIT_EXCEPTION_ALLOCATION = 0,
 		ORBIT_EXCEPTION_INITIALIZE,
+		ORBIT_EXCEPTION_SHARD_NOT_FOUND,
 		ORBIT_EXCEPTION_UNINITIALIZE,
 	};
 
@@ -41,6 +42,7 @@ namespace ORBIT {
 	static const std::string ORBIT_EXCEPTION_STR[] = {
 		ORBIT_EXCEPTION_HEADER " Failed to allocate library",
 		ORBIT_EXCEPTION_HEADER " Library is initialized",
+		ORBIT_EXCEPTION_HEADER " Library shard does not exist",
 		ORBIT_EXCEPTION_HEADER " Library is uninitialized",
 		};
 
@@ -20,8 +20,10 @@
 #ifndef ORBIT_UID_H_
 #define ORBIT_UID_H_
 
+#include <atomic>
+#include <deque>
 #include <map>
-#include <set>
+#include <type_traits>
 
 namespace ORBIT {
 
@@ -30,6 +32,20 @@ namespace ORBIT {
 		typedef uint32_t orbit_uid_t;
 
 		#define UID_INVALID INVALID_TYPE(orbit_uid_t)
+		#define UID_INDEX_BITS 0x18
+		#define UID_INDEX_MASK ((1 << UID_INDEX_BITS) - 1)
+		#define UID_GENERATION_MASK 0xff
+		#define UID_INDEX(_UID_) ((_UID_) & UID_INDEX_MASK)
+		#define UID_GENERATION(_UID_) (((_UID_) >> UID_INDEX_BITS) & UID_GENERATION_MASK)
+		#define UID_MAKE(_INDEX_, _GENERATION_) \
+			((orbit_uid_t) ((((_GENERATION_) & UID_GENERATION_MASK) << UID_INDEX_BITS) \
+			| ((_INDEX_) & UID_INDEX_MASK)))
+
+		#define UID_CHUNK_SHIFT 0x10
+		#define UID_CHUNK_LEN (1 << UID_CHUNK_SHIFT)
+		#define UID_CHUNK_COUNT ((UID_INDEX_MASK >> UID_CHUNK_SHIFT) + 1)
+
+		#define UID_RANGE_MAX 0x100
 
 		typedef class _orbit_uid {
 
@@ -41,32 +57,36 @@ namespace ORBIT {
 
 				_orbit_uid(
 					__in const _orbit_uid &other
-					);
+					) = default;
 
-				virtual ~_orbit_uid(void);
+				~_orbit_uid(void) = default;
 
 				_orbit_uid &operator=(
 					__in const _orbit_uid &other
-					);
+					) = default;
 
 				bool operator==(
 					__in const _orbit_uid &other
-					);
+					) const;
 
 				bool operator!=(
 					__in const _orbit_uid &other
-					);
+					) const;
 
 				static std::string as_string(
 					__in const _orbit_uid &uid,
 					__in_opt bool verbose = false
 					);
 
-				virtual std::string to_string(
+				uint8_t generation(void) const;
+
+				uint32_t index(void) const;
+
+				std::string to_string(
 					__in_opt bool verbose = false
-					);
+					) const;
 
-				orbit_uid_t &uid(void);
+				orbit_uid_t uid(void) const;
 
 			protected:
 
@@ -79,12 +99,11 @@ namespace ORBIT {
 
 				orbit_uid_t m_uid;
 
-			private:
-
-				std::recursive_mutex m_lock;
-
 		} orbit_uid, *orbit_uid_ptr;
 
+		static_assert(sizeof(orbit_uid) == sizeof(orbit_uid_t), "orbit_uid must remain a bare uid");
+		static_assert(std::is_trivially_copyable<orbit_uid>::value, "orbit_uid must be trivially copyable");
+
 		extern bool operator<(
 			__in const _orbit_uid &left,
 			__in const _orbit_uid &right
@@ -101,12 +120,20 @@ namespace ORBIT {
 					__in const _orbit_uid_class &other
 					);
 
+				_orbit_uid_class(
+					__in _orbit_uid_class &&other
+					) noexcept;
+
 				virtual ~_orbit_uid_class(void);
 
 				_orbit_uid_class &operator=(
 					__in const _orbit_uid_class &other
 					);
 
+				_orbit_uid_class &operator=(
+					__in _orbit_uid_class &&other
+					) noexcept;
+
 				bool contains(void);
 
 				size_t decrement_reference(void);
@@ -115,12 +142,17 @@ namespace ORBIT {
 
 				size_t reference_count(void);
 
-			private:
+			protected:
 
-				std::recursive_mutex m_lock;
+				void clear(void);
 
 		} orbit_uid_class, *orbit_uid_class_ptr;
 
+		typedef struct _orbit_uid_range {
+			std::deque<uint32_t> free;
+			std::atomic<uint32_t> next;
+		} orbit_uid_range, *orbit_uid_range_ptr;
+
 		typedef class _orbit_uid_factory {
 
 			public:
@@ -139,11 +171,18 @@ namespace ORBIT {
 
 				orbit_uid generate(void);
 
+				void generate_n(
+					__in size_t count,
+					__out std::vector<orbit_uid> &uid
+					);
+
 				size_t increment_reference(
 					__in const orbit_uid &uid
 					);
 
-				void initialize(void);
+				void initialize(
+					__in_opt uint32_t ranges = 1
+					);
 
 				static bool is_allocated(void);
 
@@ -153,6 +192,25 @@ namespace ORBIT {
 					__in const orbit_uid &uid
 					);
 
+				size_t reference_count(
+					__in const orbit_uid &uid,
+					__out int &error
+					);
+
+				uint32_t range(
+					__in const orbit_uid &uid
+					);
+
+				uint32_t range_count(void);
+
+				uint32_t range_select(
+					__in uint32_t range
+					);
+
+				size_t release_n(
+					__in const std::vector<orbit_uid> &uid
+					);
+
 				size_t size(void);
 
 				std::string to_string(
@@ -173,21 +231,51 @@ namespace ORBIT {
 					__in const _orbit_uid_factory &other
 					);
 
+				friend struct _orbit_uid_cache;
+
 				static void _delete(void);
 
-				std::map<orbit_uid, size_t>::iterator find(
+				void cache_refresh(void);
+
+				bool drop(
+					__in const orbit_uid &uid,
+					__out uint32_t &count
+					);
+
+				std::atomic<uint64_t> &find(
 					__in const orbit_uid &uid
 					);
 
-				bool m_initialized;
+				void release(
+					__in const orbit_uid &uid
+					);
+
+				void release_cache(
+					__inout std::deque<uint32_t> &cache,
+					__in uint32_t epoch,
+					__in uint32_t range
+					);
+
+				std::atomic<uint64_t> *slot(
+					__in uint32_t index,
+					__in bool allocate
+					);
+
+				std::atomic<uint32_t> m_epoch;
+
+				std::atomic<bool> m_initialized;
 
 				static _orbit_uid_factory *m_instance;
 
-				std::map<orbit_uid, size_t> m_map_uid;
+				orbit_uid_range_ptr m_range;
 
-				orbit_uid_t m_next_uid;
+				uint32_t m_range_count;
 
-				std::set<orbit_uid_t> m_set_uid;
+				uint32_t m_range_length;
+
+				std::atomic<std::atomic<uint64_t> *> m_slot[UID_CHUNK_COUNT];
+
+				std::atomic<size_t> m_size;
 
 			private:
 
@@ -197,4 +285,17 @@ namespace ORBIT {
 	}
 }
 
+namespace std {
+
+	template<> struct hash<ORBIT::COMPONENT::orbit_uid> {
+
+		size_t operator()(
+			__in const ORBIT::COMPONENT::orbit_uid &uid
+			) const
+		{
+			return hash<ORBIT::COMPONENT::orbit_uid_t>()(uid.uid());
+		}
+	};
+}
+
 #endif // ORBIT_UID_H_
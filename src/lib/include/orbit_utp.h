@@ -0,0 +1,368 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_UTP_H_
+#define ORBIT_UTP_H_
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define UTP_AGAIN INVALID_TYPE(int)
+		#define UTP_CONNECT_TIMEOUT 5000
+
+		typedef enum {
+			ORBIT_UTP_STATE_NONE = 0,
+			ORBIT_UTP_STATE_SYN_SENT,
+			ORBIT_UTP_STATE_CONNECTED,
+			ORBIT_UTP_STATE_FIN_SENT,
+			ORBIT_UTP_STATE_RESET,
+		} orbit_utp_state_t;
+
+		#define ORBIT_UTP_STATE_MAX ORBIT_UTP_STATE_RESET
+
+		typedef enum {
+			ORBIT_UTP_PACKET_DATA = 0,
+			ORBIT_UTP_PACKET_FIN,
+			ORBIT_UTP_PACKET_STATE,
+			ORBIT_UTP_PACKET_RESET,
+			ORBIT_UTP_PACKET_SYN,
+		} orbit_utp_packet_t;
+
+		#define ORBIT_UTP_PACKET_MAX ORBIT_UTP_PACKET_SYN
+
+		typedef struct __attribute__((packed)) _orbit_utp_header {
+			uint8_t type;
+			uint8_t extension;
+			uint16_t connection;
+			uint32_t timestamp;
+			uint32_t timestamp_difference;
+			uint32_t window;
+			uint16_t sequence;
+			uint16_t acknowledge;
+		} orbit_utp_header, *orbit_utp_header_ptr;
+
+		typedef struct _orbit_utp_packet {
+			orbit_buf_t data;
+			uint16_t sequence;
+			uint64_t time;
+			uint32_t transmissions;
+		} orbit_utp_packet, *orbit_utp_packet_ptr;
+
+		class _orbit_utp;
+
+		class _orbit_utp_connection;
+
+		typedef std::shared_ptr<_orbit_utp_connection> orbit_utp_connection_handle;
+
+		typedef std::function<void(const orbit_utp_connection_handle &)> orbit_utp_accept_cb;
+
+		typedef std::function<void(const orbit_utp_connection_handle &, int)> orbit_utp_connect_cb;
+
+		typedef std::function<void(const orbit_utp_connection_handle &, uint32_t)> orbit_utp_event_cb;
+
+		typedef class _orbit_utp_connection {
+
+			public:
+
+				_orbit_utp_connection(void);
+
+				~_orbit_utp_connection(void);
+
+				void close(void);
+
+				bool is_connected(void);
+
+				int read(
+					__out uint8_t *output,
+					__in size_t length
+					);
+
+				orbit_utp_state_t state(void);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void unwatch(void);
+
+				void watch(
+					__in const orbit_utp_event_cb &callback
+					);
+
+				uint32_t window(void);
+
+				int write(
+					__in const uint8_t *input,
+					__in size_t length
+					);
+
+			protected:
+
+				friend class _orbit_utp;
+
+				_orbit_utp_connection(
+					__in const _orbit_utp_connection &other
+					) = delete;
+
+				_orbit_utp_connection &operator=(
+					__in const _orbit_utp_connection &other
+					) = delete;
+
+				void acknowledge(
+					__in uint16_t sequence,
+					__in uint32_t delay
+					);
+
+				void detach(void);
+
+				uint32_t handle(
+					__in const orbit_utp_header &header,
+					__in const uint8_t *input,
+					__in size_t length
+					);
+
+				bool is_finished(
+					__in uint64_t now
+					);
+
+				void notify(
+					__in const orbit_utp_connection_handle &self,
+					__in uint32_t events
+					);
+
+				uint32_t receive(
+					__in uint16_t sequence,
+					__in const uint8_t *input,
+					__in size_t length
+					);
+
+				void send(
+					__in orbit_utp_packet_t type,
+					__in_opt const uint8_t *input = NULL,
+					__in_opt size_t length = 0
+					);
+
+				void send_packet(
+					__inout orbit_utp_packet &packet
+					);
+
+				void send_pending(void);
+
+				uint32_t timeout(
+					__in uint64_t now
+					);
+
+				uint16_t m_acknowledge;
+
+				uint32_t m_acknowledge_duplicate;
+
+				bool m_blocked;
+
+				uint64_t m_close_deadline;
+
+				bool m_closing;
+
+				orbit_utp_connect_cb m_connect;
+
+				uint64_t m_connect_deadline;
+
+				int m_connect_error;
+
+				uint16_t m_connection_receive;
+
+				uint16_t m_connection_send;
+
+				uint32_t m_delay_base[2];
+
+				uint64_t m_delay_time;
+
+				bool m_eof;
+
+				uint16_t m_eof_sequence;
+
+				bool m_fin;
+
+				std::deque<orbit_utp_packet> m_flight;
+
+				size_t m_flight_length;
+
+				_orbit_utp *m_owner;
+
+				sockaddr_storage m_peer;
+
+				socklen_t m_peer_length;
+
+				orbit_buf_t m_receive;
+
+				size_t m_receive_offset;
+
+				uint16_t m_recover;
+
+				bool m_recovering;
+
+				std::map<uint16_t, orbit_buf_t> m_reorder;
+
+				size_t m_reorder_length;
+
+				uint32_t m_rtt;
+
+				uint32_t m_rtt_variance;
+
+				uint64_t m_rto;
+
+				orbit_buf_t m_send;
+
+				size_t m_send_offset;
+
+				uint16_t m_sequence;
+
+				orbit_utp_state_t m_state;
+
+				uint32_t m_timestamp_difference;
+
+				orbit_utp_event_cb m_watch;
+
+				uint32_t m_window_max;
+
+				uint32_t m_window_peer;
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_utp_connection, *orbit_utp_connection_ptr;
+
+		typedef std::pair<std::string, uint16_t> orbit_utp_key;
+
+		typedef class _orbit_utp {
+
+			public:
+
+				_orbit_utp(void);
+
+				~_orbit_utp(void);
+
+				void accept(
+					__in const orbit_utp_accept_cb &callback
+					);
+
+				orbit_utp_connection_handle connect(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in const orbit_utp_connect_cb &complete,
+					__in_opt uint32_t timeout = UTP_CONNECT_TIMEOUT
+					);
+
+				void initialize(
+					__in const std::string &host,
+					__in uint16_t port,
+					__in_opt orbit_event_ptr event = NULL
+					);
+
+				bool is_initialized(void);
+
+				uint16_t port(void);
+
+				size_t size(void);
+
+				std::string to_string(
+					__in_opt bool verbose = false
+					);
+
+				void uninitialize(void);
+
+			protected:
+
+				friend class _orbit_utp_connection;
+
+				_orbit_utp(
+					__in const _orbit_utp &other
+					) = delete;
+
+				_orbit_utp &operator=(
+					__in const _orbit_utp &other
+					) = delete;
+
+				void connect_fail(
+					__in const orbit_utp_connection_handle &connection,
+					__in int error
+					);
+
+				void connect_start(
+					__in const orbit_utp_connection_handle &connection,
+					__in uint16_t port,
+					__in int error,
+					__in const orbit_resolver_address_t &address
+					);
+
+				void dispatch(void);
+
+				bool key(
+					__in const sockaddr_storage &address,
+					__in uint16_t connection,
+					__out orbit_utp_key &result
+					);
+
+				void reset(
+					__in const orbit_socket_datagram &datagram,
+					__in const orbit_utp_header &header
+					);
+
+				void tick(void);
+
+				int transmit(
+					__in const sockaddr_storage &address,
+					__in socklen_t length,
+					__in const uint8_t *input,
+					__in size_t size
+					);
+
+				orbit_utp_accept_cb m_accept;
+
+				std::vector<orbit_socket_datagram> m_batch;
+
+				std::map<orbit_utp_key, orbit_utp_connection_handle> m_connection;
+
+				std::atomic<int> m_descriptor;
+
+				orbit_event_ptr m_event;
+
+				std::shared_ptr<bool> m_guard;
+
+				bool m_initialized;
+
+				orbit_socket m_socket;
+
+				orbit_timer_t m_timer;
+
+			private:
+
+				std::recursive_mutex m_lock;
+
+		} orbit_utp, *orbit_utp_ptr;
+	}
+}
+
+#endif // ORBIT_UTP_H_
@@ -0,0 +1,72 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ORBIT_UTP_TYPE_H_
+#define ORBIT_UTP_TYPE_H_
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define ORBIT_UTP_HEADER "(UTP)"
+
+		#ifndef NDEBUG
+		#define ORBIT_UTP_EXCEPTION_HEADER ORBIT_UTP_HEADER
+		#else
+		#define ORBIT_UTP_EXCEPTION_HEADER EXCEPTION_HEADER
+		#endif // NDEBUG
+
+		enum {
+			ORBIT_UTP_EXCEPTION_CONNECTED = 0,
+			ORBIT_UTP_EXCEPTION_DISCONNECTED,
+			ORBIT_UTP_EXCEPTION_INITIALIZE,
+			ORBIT_UTP_EXCEPTION_INTERNAL,
+			ORBIT_UTP_EXCEPTION_RESET,
+			ORBIT_UTP_EXCEPTION_UNINITIALIZE,
+		};
+
+		#define ORBIT_UTP_EXCEPTION_MAX ORBIT_UTP_EXCEPTION_UNINITIALIZE
+
+		static const std::string ORBIT_UTP_EXCEPTION_STR[] = {
+			ORBIT_UTP_EXCEPTION_HEADER " Utp component is connected",
+			ORBIT_UTP_EXCEPTION_HEADER " Utp component is disconnected",
+			ORBIT_UTP_EXCEPTION_HEADER " Utp component is initialized",
+			ORBIT_UTP_EXCEPTION_HEADER " Internal utp exception",
+			ORBIT_UTP_EXCEPTION_HEADER " Utp component peer reset connection",
+			ORBIT_UTP_EXCEPTION_HEADER " Utp component is uninitialized",
+			};
+
+		#define ORBIT_UTP_EXCEPTION_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_UTP_EXCEPTION_MAX ? UNKNOWN_EXCEPTION : \
+			CHECK_STR(ORBIT_UTP_EXCEPTION_STR[_TYPE_]))
+
+		#define THROW_ORBIT_UTP_EXCEPTION(_EXCEPT_) \
+			THROW_EXCEPTION(ORBIT_UTP_EXCEPTION_STRING(_EXCEPT_))
+		#define THROW_ORBIT_UTP_EXCEPTION_MESSAGE(_EXCEPT_, _FORMAT_, ...) \
+			THROW_EXCEPTION_MESSAGE(ORBIT_UTP_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+
+		class _orbit_utp;
+		typedef _orbit_utp orbit_utp, *orbit_utp_ptr;
+
+		class _orbit_utp_connection;
+		typedef _orbit_utp_connection orbit_utp_connection, *orbit_utp_connection_ptr;
+	}
+}
+
+#endif // ORBIT_UTP_TYPE_H_
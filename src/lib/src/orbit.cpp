@@ -17,6 +17,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <sched.h>
 #include "../include/orbit.h"
 #include "../include/orbit_type.h"
 
@@ -25,9 +26,13 @@ namespace ORBIT {
 	orbit_ptr orbit::m_instance = NULL;
 
 	_orbit::_orbit(void) :
+		m_factory_buffer(orbit_buffer_factory::acquire()),
 		m_factory_socket(orbit_socket_factory::acquire()),
 		m_factory_uid(orbit_uid_factory::acquire()),
-		m_initialized(false)
+		m_initialized(false),
+		m_resolver(orbit_resolver::acquire()),
+		m_shard_next(0),
+		m_task(orbit_task::acquire())
 	{
 		std::atexit(orbit::_delete);
 	}
@@ -50,6 +55,14 @@ namespace ORBIT {
 		}
 	}
 
+	orbit_uid 
+	_orbit::accept(
+		__in const orbit_uid &uid
+		)
+	{
+		return acquire_shard(uid)->accept(uid);
+	}
+
 	orbit_ptr 
 	_orbit::acquire(void)
 	{
@@ -65,6 +78,57 @@ namespace ORBIT {
 		return orbit::m_instance;
 	}
 
+	orbit_buffer_factory_ptr 
+	_orbit::acquire_buffer_factory(void)
+	{
+		SERIALIZE_CALL_RECUR(m_lock);
+		return m_factory_buffer;
+	}
+
+	orbit_resolver_ptr 
+	_orbit::acquire_resolver(void)
+	{
+		SERIALIZE_CALL_RECUR(m_lock);
+		return m_resolver;
+	}
+
+	orbit_shard_ptr 
+	_orbit::acquire_shard(
+		__in const orbit_uid &uid
+		)
+	{
+		uint32_t range;
+
+		SERIALIZE_CALL_RECUR(m_lock);
+
+		if(m_shard.empty()) {
+			THROW_ORBIT_EXCEPTION_MESSAGE(ORBIT_EXCEPTION_SHARD_NOT_FOUND,
+				"%s", CHECK_STR(orbit_uid::as_string(uid)));
+		}
+
+		range = m_factory_uid->range(uid);
+		if(range && (range <= m_shard.size())) {
+			return m_shard[range - 1];
+		}
+
+		return m_shard[std::hash<orbit_uid>()(uid) % m_shard.size()];
+	}
+
+	orbit_shard_ptr 
+	_orbit::acquire_shard(
+		__in size_t index
+		)
+	{
+		SERIALIZE_CALL_RECUR(m_lock);
+
+		if(index >= m_shard.size()) {
+			THROW_ORBIT_EXCEPTION_MESSAGE(ORBIT_EXCEPTION_SHARD_NOT_FOUND,
+				"%zu", index);
+		}
+
+		return m_shard[index];
+	}
+
 	orbit_socket_factory_ptr 
 	_orbit::acquire_socket_factory(void)
 	{
@@ -72,6 +136,12 @@ namespace ORBIT {
 		return m_factory_socket;
 	}
 
+	orbit_task_ptr 
+	_orbit::acquire_task(void)
+	{
+		return m_task;
+	}
+
 	orbit_uid_factory_ptr 
 	_orbit::acquire_uid_factory(void)
 	{
@@ -79,18 +149,124 @@ namespace ORBIT {
 		return m_factory_uid;
 	}
 
+	orbit_uid 
+	_orbit::generate_tcp(
+		__in_opt const std::string &host,
+		__in_opt uint16_t port
+		)
+	{
+		size_t count = shard_count();
+
+		if(!count) {
+			THROW_ORBIT_EXCEPTION_MESSAGE(ORBIT_EXCEPTION_SHARD_NOT_FOUND,
+				"%s:%u", CHECK_STR(host), port);
+		}
+
+		return acquire_shard(m_shard_next++ % count)->generate_tcp(host, port);
+	}
+
+	orbit_uid 
+	_orbit::generate_udp(
+		__in_opt const std::string &host,
+		__in_opt uint16_t port
+		)
+	{
+		size_t count = shard_count();
+
+		if(!count) {
+			THROW_ORBIT_EXCEPTION_MESSAGE(ORBIT_EXCEPTION_SHARD_NOT_FOUND,
+				"%s:%u", CHECK_STR(host), port);
+		}
+
+		return acquire_shard(m_shard_next++ % count)->generate_udp(host, port);
+	}
+
 	void 
-	_orbit::initialize(void)
+	_orbit::initialize(
+		__in_opt size_t shards,
+		__in_opt size_t workers
+		)
 	{
+		cpu_set_t set;
+		size_t iter = 0;
+		std::vector<int> core;
+		orbit_shard_ptr entry;
+
 		SERIALIZE_CALL_RECUR(m_lock);
 
 		if(m_initialized) {
 			THROW_ORBIT_EXCEPTION(ORBIT_EXCEPTION_INITIALIZE);
 		}
 
+		if(shards >= UID_RANGE_MAX) {
+			THROW_ORBIT_EXCEPTION_MESSAGE(ORBIT_EXCEPTION_SHARD_NOT_FOUND,
+				"%zu", shards);
+		}
+
 		m_initialized = true;
-		m_factory_uid->initialize();
-		m_factory_socket->initialize();
+
+		try {
+			m_factory_buffer->initialize();
+			m_factory_uid->initialize(shards + 1);
+			m_resolver->initialize();
+			m_factory_socket->initialize();
+			m_task->initialize(workers);
+
+			if(shards) {
+				CPU_ZERO(&set);
+
+				if(!sched_getaffinity(0, sizeof(set), &set)) {
+
+					for(; iter < CPU_SETSIZE; ++iter) {
+
+						if(CPU_ISSET(iter, &set)) {
+							core.push_back(iter);
+						}
+					}
+				}
+
+				for(iter = 0; iter < shards; ++iter) {
+
+					entry = new orbit_shard(iter, iter + 1, core.empty() ? -1 : core.at(iter % core.size()));
+					if(!entry) {
+						THROW_ORBIT_EXCEPTION(ORBIT_EXCEPTION_ALLOCATION);
+					}
+
+					m_shard.push_back(entry);
+					entry->initialize();
+				}
+			}
+		} catch(...) {
+
+			for(iter = 0; iter < m_shard.size(); ++iter) {
+				delete m_shard[iter];
+			}
+
+			m_shard.clear();
+
+			if(m_task->is_initialized()) {
+				m_task->uninitialize();
+			}
+
+			if(m_factory_socket->is_initialized()) {
+				m_factory_socket->uninitialize();
+			}
+
+			if(m_resolver->is_initialized()) {
+				m_resolver->uninitialize();
+			}
+
+			if(m_factory_uid->is_initialized()) {
+				m_factory_uid->uninitialize();
+			}
+
+			if(m_factory_buffer->is_initialized()) {
+				m_factory_buffer->uninitialize();
+			}
+
+			m_initialized = false;
+			throw;
+		}
 
 		// TODO
 	}
@@ -104,16 +280,23 @@ namespace ORBIT {
 	bool 
 	_orbit::is_initialized(void)
 	{
-		SERIALIZE_CALL_RECUR(m_lock);
 		return m_initialized;
 	}
 
+	size_t 
+	_orbit::shard_count(void)
+	{
+		SERIALIZE_CALL_RECUR(m_lock);
+		return m_shard.size();
+	}
+
 	std::string 
 	_orbit::to_string(
 		__in_opt bool verbose
 		)
 	{
 		std::stringstream result;
+		std::vector<orbit_shard_ptr>::iterator iter;
 
 		SERIALIZE_CALL_RECUR(m_lock);
 
@@ -124,8 +307,15 @@ namespace ORBIT {
 			result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
 		}
 
-		result << std::endl << m_factory_socket->to_string(verbose) 
-			<< std::endl << m_factory_uid->to_string(verbose);
+		result << std::endl << m_factory_buffer->to_string(verbose)
+			<< std::endl << m_factory_socket->to_string(verbose) 
+			<< std::endl << m_factory_uid->to_string(verbose)
+			<< std::endl << m_resolver->to_string(verbose)
+			<< std::endl << m_task->to_string(verbose);
+
+		for(iter = m_shard.begin(); iter != m_shard.end(); ++iter) {
+			result << std::endl << (*iter)->to_string(verbose);
+		}
 
 		// TODO
 
@@ -135,6 +325,8 @@ namespace ORBIT {
 	void 
 	_orbit::uninitialize(void)
 	{
+		std::vector<orbit_shard_ptr>::iterator iter;
+
 		SERIALIZE_CALL_RECUR(m_lock);
 
 		if(!m_initialized) {
@@ -143,8 +335,16 @@ namespace ORBIT {
 
 		// TODO
 
+		for(iter = m_shard.begin(); iter != m_shard.end(); ++iter) {
+			delete *iter;
+		}
+
+		m_shard.clear();
+		m_task->uninitialize();
 		m_factory_socket->uninitialize();
+		m_resolver->uninitialize();
 		m_factory_uid->uninitialize();
+		m_factory_buffer->uninitialize();
 		m_initialized = false;
 	}
 
@@ -0,0 +1,473 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include "../include/orbit.h"
+#include "../include/orbit_buffer_type.h"
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define BUFFER_CACHE_LEN 0x40
+		#define BUFFER_POOL_MAX 0x1000
+
+		static const size_t BUFFER_CLASS_LEN[] = {
+			BUFFER_MESSAGE_LEN, BUFFER_BLOCK_LEN,
+			};
+
+		static const std::string BUFFER_CLASS_STR[] = {
+			"MESSAGE", "BLOCK", "NONE",
+			};
+
+		#define BUFFER_CLASS_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_BUFFER_CLASS_MAX ? UNKNOWN : \
+			CHECK_STR(BUFFER_CLASS_STR[_TYPE_]))
+
+		static orbit_buffer_block_ptr 
+		buffer_block_allocate(
+			__in orbit_buffer_class_t type,
+			__in size_t capacity
+			)
+		{
+			orbit_buffer_block_ptr result;
+
+			result = (orbit_buffer_block_ptr) malloc(sizeof(orbit_buffer_block) + capacity);
+			if(!result) {
+				THROW_ORBIT_BUFFER_EXCEPTION_MESSAGE(ORBIT_BUFFER_EXCEPTION_ALLOCATION,
+					"%zu", capacity);
+			}
+
+			new (&result->reference) std::atomic<size_t>(0);
+			result->capacity = capacity;
+			result->length = 0;
+			result->type = type;
+
+			return result;
+		}
+
+		static void 
+		buffer_block_free(
+			__in orbit_buffer_block_ptr block
+			)
+		{
+			free(block);
+		}
+
+		typedef struct _orbit_buffer_cache {
+
+			~_orbit_buffer_cache(void)
+			{
+				size_t type = 0;
+				std::vector<orbit_buffer_block_ptr>::iterator iter;
+
+				for(; type < ORBIT_BUFFER_CLASS_MAX; ++type) {
+
+					for(iter = entry[type].begin(); iter != entry[type].end(); ++iter) {
+						buffer_block_free(*iter);
+					}
+
+					entry[type].clear();
+				}
+			}
+
+			std::vector<orbit_buffer_block_ptr> entry[ORBIT_BUFFER_CLASS_MAX];
+		} orbit_buffer_cache;
+
+		static thread_local orbit_buffer_cache buffer_cache;
+
+		_orbit_buffer::_orbit_buffer(void) :
+			m_block(NULL)
+		{
+			return;
+		}
+
+		_orbit_buffer::_orbit_buffer(
+			__in size_t length
+			) :
+				m_block(orbit_buffer_factory::acquire()->allocate(length))
+		{
+			return;
+		}
+
+		_orbit_buffer::_orbit_buffer(
+			__in const _orbit_buffer &other
+			) :
+				m_block(other.m_block)
+		{
+
+			if(m_block) {
+				m_block->reference.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		_orbit_buffer::~_orbit_buffer(void)
+		{
+			clear();
+		}
+
+		_orbit_buffer &
+		_orbit_buffer::operator=(
+			__in const _orbit_buffer &other
+			)
+		{
+
+			if(m_block != other.m_block) {
+				clear();
+
+				m_block = other.m_block;
+				if(m_block) {
+					m_block->reference.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			return *this;
+		}
+
+		uint8_t &
+		_orbit_buffer::operator[](
+			__in size_t position
+			)
+		{
+
+			if(!m_block) {
+				THROW_ORBIT_BUFFER_EXCEPTION(ORBIT_BUFFER_EXCEPTION_EMPTY);
+			}
+
+			if(position >= m_block->length) {
+				THROW_ORBIT_BUFFER_EXCEPTION_MESSAGE(ORBIT_BUFFER_EXCEPTION_CAPACITY,
+					"%zu/%zu", position, m_block->length);
+			}
+
+			return data()[position];
+		}
+
+		size_t 
+		_orbit_buffer::capacity(void) const
+		{
+			return (m_block ? m_block->capacity : 0);
+		}
+
+		void 
+		_orbit_buffer::clear(void)
+		{
+
+			if(m_block) {
+
+				if(m_block->reference.fetch_sub(1, std::memory_order_acq_rel) == REFERENCE_INIT) {
+					orbit_buffer_factory::acquire()->release(m_block);
+				}
+
+				m_block = NULL;
+			}
+		}
+
+		uint8_t *
+		_orbit_buffer::data(void) const
+		{
+			return (m_block ? (uint8_t *) (m_block + 1) : NULL);
+		}
+
+		bool 
+		_orbit_buffer::empty(void) const
+		{
+			return (!m_block || !m_block->length);
+		}
+
+		size_t 
+		_orbit_buffer::length(void) const
+		{
+			return (m_block ? m_block->length : 0);
+		}
+
+		size_t 
+		_orbit_buffer::reference_count(void) const
+		{
+			return (m_block ? m_block->reference.load(std::memory_order_relaxed) : 0);
+		}
+
+		void 
+		_orbit_buffer::resize(
+			__in size_t length
+			)
+		{
+
+			if(!m_block) {
+				THROW_ORBIT_BUFFER_EXCEPTION(ORBIT_BUFFER_EXCEPTION_EMPTY);
+			}
+
+			if(length > m_block->capacity) {
+				THROW_ORBIT_BUFFER_EXCEPTION_MESSAGE(ORBIT_BUFFER_EXCEPTION_CAPACITY,
+					"%zu/%zu", length, m_block->capacity);
+			}
+
+			m_block->length = length;
+		}
+
+		std::string 
+		_orbit_buffer::to_string(
+			__in_opt bool verbose
+			) const
+		{
+			std::stringstream result;
+
+			result << ORBIT_BUFFER_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, m_block) << ")";
+			}
+
+			result << " " << BUFFER_CLASS_STRING(type()) << ", len: " << length() 
+				<< "/" << capacity() << ", ref: " << reference_count();
+
+			return CHECK_STR(result.str());
+		}
+
+		orbit_buffer_class_t 
+		_orbit_buffer::type(void) const
+		{
+			return (m_block ? m_block->type : ORBIT_BUFFER_CLASS_NONE);
+		}
+
+		orbit_buffer_factory_ptr orbit_buffer_factory::m_instance = NULL;
+
+		_orbit_buffer_factory::_orbit_buffer_factory(void) :
+			m_initialized(false)
+		{
+			std::atexit(orbit_buffer_factory::_delete);
+		}
+
+		_orbit_buffer_factory::~_orbit_buffer_factory(void)
+		{
+
+			if(m_initialized) {
+				uninitialize();
+			}
+		}
+
+		void 
+		_orbit_buffer_factory::_delete(void)
+		{
+
+			if(orbit_buffer_factory::m_instance) {
+				delete orbit_buffer_factory::m_instance;
+				orbit_buffer_factory::m_instance = NULL;
+			}
+		}
+
+		orbit_buffer_factory_ptr 
+		_orbit_buffer_factory::acquire(void)
+		{
+
+			if(!orbit_buffer_factory::m_instance) {
+
+				orbit_buffer_factory::m_instance = new orbit_buffer_factory;
+				if(!orbit_buffer_factory::m_instance) {
+					THROW_ORBIT_BUFFER_EXCEPTION(ORBIT_BUFFER_EXCEPTION_ALLOCATION);
+				}
+			}
+
+			return orbit_buffer_factory::m_instance;
+		}
+
+		orbit_buffer_block_ptr 
+		_orbit_buffer_factory::allocate(
+			__in size_t length
+			)
+		{
+			size_t count;
+			orbit_buffer_block_ptr result = NULL;
+			orbit_buffer_class_t type = ORBIT_BUFFER_CLASS_MESSAGE;
+
+			if(!m_initialized) {
+				THROW_ORBIT_BUFFER_EXCEPTION(ORBIT_BUFFER_EXCEPTION_UNINITIALIZE);
+			}
+
+			for(; type < ORBIT_BUFFER_CLASS_MAX; type = (orbit_buffer_class_t) (type + 1)) {
+
+				if(length <= BUFFER_CLASS_LEN[type]) {
+					break;
+				}
+			}
+
+			if(type == ORBIT_BUFFER_CLASS_NONE) {
+				result = buffer_block_allocate(type, length);
+			} else {
+				std::vector<orbit_buffer_block_ptr> &cache = buffer_cache.entry[type];
+
+				if(cache.empty()) {
+					SERIALIZE_CALL_RECUR(m_lock);
+
+					count = std::min((size_t) (BUFFER_CACHE_LEN / 2), m_pool[type].size());
+					if(count) {
+						cache.insert(cache.end(), m_pool[type].end() - count, m_pool[type].end());
+						m_pool[type].resize(m_pool[type].size() - count);
+					}
+				}
+
+				if(!cache.empty()) {
+					result = cache.back();
+					cache.pop_back();
+				} else {
+					result = buffer_block_allocate(type, BUFFER_CLASS_LEN[type]);
+				}
+			}
+
+			result->reference.store(REFERENCE_INIT, std::memory_order_relaxed);
+			result->length = length;
+
+			return result;
+		}
+
+		void 
+		_orbit_buffer_factory::initialize(void)
+		{
+			size_t type = 0;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_initialized) {
+				THROW_ORBIT_BUFFER_EXCEPTION(ORBIT_BUFFER_EXCEPTION_INITIALIZE);
+			}
+
+			for(; type < ORBIT_BUFFER_CLASS_MAX; ++type) {
+				m_pool[type].reserve(BUFFER_POOL_MAX);
+			}
+
+			m_initialized = true;
+		}
+
+		bool 
+		_orbit_buffer_factory::is_allocated(void)
+		{
+			return (orbit_buffer_factory::m_instance != NULL);
+		}
+
+		bool 
+		_orbit_buffer_factory::is_initialized(void)
+		{
+			return m_initialized;
+		}
+
+		void 
+		_orbit_buffer_factory::release(
+			__in orbit_buffer_block_ptr block
+			)
+		{
+			size_t count;
+			std::vector<orbit_buffer_block_ptr>::iterator iter;
+
+			if(block->type >= ORBIT_BUFFER_CLASS_MAX) {
+				buffer_block_free(block);
+				return;
+			}
+
+			std::vector<orbit_buffer_block_ptr> &cache = buffer_cache.entry[block->type];
+
+			if(cache.size() >= BUFFER_CACHE_LEN) {
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				std::vector<orbit_buffer_block_ptr> &pool = m_pool[block->type];
+
+				count = BUFFER_CACHE_LEN / 2;
+				for(iter = cache.end() - count; iter != cache.end(); ++iter) {
+
+					if(m_initialized && (pool.size() < BUFFER_POOL_MAX)) {
+						pool.push_back(*iter);
+					} else {
+						buffer_block_free(*iter);
+					}
+				}
+
+				cache.resize(cache.size() - count);
+			}
+
+			cache.push_back(block);
+		}
+
+		size_t 
+		_orbit_buffer_factory::size(
+			__in orbit_buffer_class_t type
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_BUFFER_EXCEPTION(ORBIT_BUFFER_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(type >= ORBIT_BUFFER_CLASS_MAX) {
+				THROW_ORBIT_BUFFER_EXCEPTION_MESSAGE(ORBIT_BUFFER_EXCEPTION_TYPE,
+					"%x", type);
+			}
+
+			return (m_pool[type].size() + buffer_cache.entry[type].size());
+		}
+
+		std::string 
+		_orbit_buffer_factory::to_string(
+			__in_opt bool verbose
+			)
+		{
+			size_t type = 0;
+			std::stringstream result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << "[" << (m_initialized ? "INIT" : "UNINIT") << "] " 
+				<< ORBIT_BUFFER_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			for(; type < ORBIT_BUFFER_CLASS_MAX; ++type) {
+				result << std::endl << "--- [" << (type + 1) << "/" << ORBIT_BUFFER_CLASS_MAX << "] "
+					<< BUFFER_CLASS_STRING(type) << ", cap: " << BUFFER_CLASS_LEN[type]
+					<< ", pool: " << m_pool[type].size() << ", cache: " << buffer_cache.entry[type].size();
+			}
+
+			return CHECK_STR(result.str());
+		}
+
+		void 
+		_orbit_buffer_factory::uninitialize(void)
+		{
+			size_t type = 0;
+			std::vector<orbit_buffer_block_ptr>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_BUFFER_EXCEPTION(ORBIT_BUFFER_EXCEPTION_UNINITIALIZE);
+			}
+
+			for(; type < ORBIT_BUFFER_CLASS_MAX; ++type) {
+
+				for(iter = m_pool[type].begin(); iter != m_pool[type].end(); ++iter) {
+					buffer_block_free(*iter);
+				}
+
+				m_pool[type].clear();
+			}
+
+			m_initialized = false;
+		}
+	}
+}
@@ -0,0 +1,886 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "../include/orbit.h"
+#include "../include/orbit_event_type.h"
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define EVENT_BATCH_LEN 0x100
+		#define EVENT_MASK (EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLRDHUP)
+		#define EVENT_MSEC_PER_SEC 1000
+		#define EVENT_NSEC_PER_MSEC 1000000
+		#define EVENT_TIMER_NONE UINT32_MAX
+		#define EVENT_WHEEL_MASK (EVENT_WHEEL_LEN - 1)
+		#define EVENT_WHEEL_SPAN(_LEVEL_) (((uint64_t) 1) << (EVENT_WHEEL_BITS * (_LEVEL_)))
+		#define EVENT_WHEEL_CEIL(_TIME_, _LEVEL_) \
+			((((_TIME_) + EVENT_WHEEL_SPAN(_LEVEL_) - 1) / EVENT_WHEEL_SPAN(_LEVEL_)) * EVENT_WHEEL_SPAN(_LEVEL_))
+		#define EVENT_WHEEL_INDEX(_TIME_, _LEVEL_) \
+			(((_TIME_) >> (EVENT_WHEEL_BITS * (_LEVEL_))) & EVENT_WHEEL_MASK)
+
+		static uint64_t 
+		event_time(void)
+		{
+			timespec now;
+
+			clock_gettime(CLOCK_MONOTONIC, &now);
+
+			return ((uint64_t) now.tv_sec * EVENT_MSEC_PER_SEC) 
+				+ (now.tv_nsec / EVENT_NSEC_PER_MSEC);
+		}
+
+		_orbit_event::_orbit_event(void) :
+			m_descriptor_epoll(0),
+			m_descriptor_timer(0),
+			m_descriptor_wake(0),
+			m_initialized(false),
+			m_running(false),
+			m_wheel_armed(TIMER_INVALID),
+			m_wheel_time(0)
+		{
+			memset(m_wheel, 0xff, sizeof(m_wheel));
+			memset(m_wheel_count, 0, sizeof(m_wheel_count));
+		}
+
+		_orbit_event::~_orbit_event(void)
+		{
+
+			if(m_initialized) {
+				uninitialize();
+			}
+		}
+
+		void 
+		_orbit_event::add(
+			__in int descriptor,
+			__in uint32_t events,
+			__in const orbit_event_cb &callback
+			)
+		{
+			epoll_event event;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			memset(&event, 0, sizeof(event));
+			event.events = (events & EVENT_MASK) | EPOLLET;
+			event.data.fd = descriptor;
+
+			if(epoll_ctl(m_descriptor_epoll, EPOLL_CTL_ADD, descriptor, &event) < 0) {
+
+				if((errno != EEXIST)
+						|| (epoll_ctl(m_descriptor_epoll, EPOLL_CTL_MOD, descriptor, &event) < 0)) {
+					THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(epoll_ctl), strerror(errno));
+				}
+			}
+
+			m_map_descriptor[descriptor] = std::pair<uint32_t, orbit_event_cb>(events, callback);
+		}
+
+		int 
+		_orbit_event::close(
+			__in int descriptor
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_initialized && (m_map_descriptor.find(descriptor) != m_map_descriptor.end())) {
+				remove(descriptor);
+			}
+
+			return ::close(descriptor);
+		}
+
+		bool 
+		_orbit_event::contains(
+			__in int descriptor
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			return (m_map_descriptor.find(descriptor) != m_map_descriptor.end());
+		}
+
+		void 
+		_orbit_event::descriptor_close(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_descriptor_wake) {
+				::close(m_descriptor_wake);
+				m_descriptor_wake = 0;
+			}
+
+			if(m_descriptor_timer) {
+				::close(m_descriptor_timer);
+				m_descriptor_timer = 0;
+			}
+
+			if(m_descriptor_epoll) {
+				::close(m_descriptor_epoll);
+				m_descriptor_epoll = 0;
+			}
+		}
+
+		bool 
+		_orbit_event::dispatch(
+			__in int descriptor,
+			__in uint32_t events
+			)
+		{
+			orbit_event_cb callback;
+			std::map<int, std::pair<uint32_t, orbit_event_cb>>::iterator entry;
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				if(!m_initialized) {
+					return false;
+				}
+
+				entry = m_map_descriptor.find(descriptor);
+				if(entry == m_map_descriptor.end()) {
+					return false;
+				}
+
+				callback = entry->second.second;
+			}
+
+			callback(descriptor, events);
+
+			return true;
+		}
+
+		void 
+		_orbit_event::initialize(void)
+		{
+			int error;
+			epoll_event event;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_INITIALIZE);
+			}
+
+			m_descriptor_epoll = epoll_create1(EPOLL_CLOEXEC);
+			if(m_descriptor_epoll < 0) {
+				error = errno;
+				m_descriptor_epoll = 0;
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(epoll_create1), strerror(error));
+			}
+
+			m_descriptor_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+			if(m_descriptor_timer < 0) {
+				error = errno;
+				m_descriptor_timer = 0;
+				descriptor_close();
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(timerfd_create), strerror(error));
+			}
+
+			m_descriptor_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if(m_descriptor_wake < 0) {
+				error = errno;
+				m_descriptor_wake = 0;
+				descriptor_close();
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(eventfd), strerror(error));
+			}
+
+			memset(&event, 0, sizeof(event));
+			event.events = EPOLLIN;
+			event.data.fd = m_descriptor_timer;
+
+			if(epoll_ctl(m_descriptor_epoll, EPOLL_CTL_ADD, m_descriptor_timer, &event) < 0) {
+				error = errno;
+				descriptor_close();
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(epoll_ctl), strerror(error));
+			}
+
+			event.data.fd = m_descriptor_wake;
+
+			if(epoll_ctl(m_descriptor_epoll, EPOLL_CTL_ADD, m_descriptor_wake, &event) < 0) {
+				error = errno;
+				descriptor_close();
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(epoll_ctl), strerror(error));
+			}
+
+			m_initialized = true;
+			m_map_descriptor.clear();
+			m_post.clear();
+			m_running = false;
+			m_timer.clear();
+			m_timer_free.clear();
+			memset(m_wheel, 0xff, sizeof(m_wheel));
+			memset(m_wheel_count, 0, sizeof(m_wheel_count));
+			m_wheel_armed = TIMER_INVALID;
+			m_wheel_time = event_time();
+		}
+
+		bool 
+		_orbit_event::is_initialized(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_initialized;
+		}
+
+		bool 
+		_orbit_event::is_running(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_running;
+		}
+
+		void 
+		_orbit_event::modify(
+			__in int descriptor,
+			__in uint32_t events
+			)
+		{
+			epoll_event event;
+			std::map<int, std::pair<uint32_t, orbit_event_cb>>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			iter = m_map_descriptor.find(descriptor);
+			if(iter == m_map_descriptor.end()) {
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_NOT_FOUND,
+					"%i", descriptor);
+			}
+
+			memset(&event, 0, sizeof(event));
+			event.events = (events & EVENT_MASK) | EPOLLET;
+			event.data.fd = descriptor;
+
+			if(epoll_ctl(m_descriptor_epoll, EPOLL_CTL_MOD, descriptor, &event) < 0) {
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(epoll_ctl), strerror(errno));
+			}
+
+			iter->second.first = events;
+		}
+
+		size_t 
+		_orbit_event::poll(
+			__in_opt int timeout
+			)
+		{
+			uint64_t value;
+			int count, descriptor, iter = 0;
+			size_t result = 0;
+			epoll_event event[EVENT_BATCH_LEN];
+			std::vector<orbit_event_post_cb> post;
+			std::vector<orbit_event_post_cb>::iterator post_iter;
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				if(!m_initialized) {
+					THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+				}
+
+				descriptor = m_descriptor_epoll;
+			}
+
+			count = epoll_wait(descriptor, event, EVENT_BATCH_LEN, timeout);
+			if(count < 0) {
+
+				if(errno == EINTR) {
+					return result;
+				}
+
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(epoll_wait), strerror(errno));
+			}
+
+			for(; iter < count; ++iter) {
+				descriptor = event[iter].data.fd;
+
+				if(descriptor == m_descriptor_timer) {
+
+					if(::read(m_descriptor_timer, &value, sizeof(value)) > 0) {
+						result += timer_dispatch();
+					}
+
+					continue;
+				} else if(descriptor == m_descriptor_wake) {
+
+					if((::read(m_descriptor_wake, &value, sizeof(value)) < 0)
+							&& (errno != EAGAIN)) {
+						THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+							"[%s] %s", CONCAT_STR(::read), strerror(errno));
+					}
+
+					{
+						SERIALIZE_CALL_RECUR(m_lock);
+						post.swap(m_post);
+					}
+
+					for(post_iter = post.begin(); post_iter != post.end(); ++post_iter) {
+						(*post_iter)();
+						++result;
+					}
+
+					post.clear();
+					continue;
+				}
+
+				if(event[iter].events & EPOLLHUP) {
+					event[iter].events |= EPOLLRDHUP;
+				}
+
+				if(dispatch(descriptor, event[iter].events & EVENT_MASK)) {
+					++result;
+				}
+			}
+
+			return result;
+		}
+
+		void 
+		_orbit_event::post(
+			__in const orbit_event_post_cb &callback
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			m_post.push_back(callback);
+			wake();
+		}
+
+		void 
+		_orbit_event::remove(
+			__in int descriptor
+			)
+		{
+			std::map<int, std::pair<uint32_t, orbit_event_cb>>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			iter = m_map_descriptor.find(descriptor);
+			if(iter == m_map_descriptor.end()) {
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_NOT_FOUND,
+					"%i", descriptor);
+			}
+
+			if((epoll_ctl(m_descriptor_epoll, EPOLL_CTL_DEL, descriptor, NULL) < 0)
+					&& (errno != ENOENT) && (errno != EBADF)) {
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(epoll_ctl), strerror(errno));
+			}
+
+			m_map_descriptor.erase(iter);
+		}
+
+		void 
+		_orbit_event::run(void)
+		{
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				if(!m_initialized) {
+					THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+				}
+
+				m_running = true;
+			}
+
+			while(is_running()) {
+				poll();
+			}
+		}
+
+		size_t 
+		_orbit_event::size(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			return m_map_descriptor.size();
+		}
+
+		void 
+		_orbit_event::stop(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			m_running = false;
+			wake();
+		}
+
+		orbit_timer_t 
+		_orbit_event::timer_add(
+			__in uint32_t timeout,
+			__in const orbit_timer_cb &callback
+			)
+		{
+			uint32_t index;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(m_timer_free.empty()) {
+				index = m_timer.size();
+				m_timer.push_back(orbit_event_timer());
+				m_timer[index].expired = false;
+				m_timer[index].generation = 0;
+			} else {
+				index = m_timer_free.back();
+				m_timer_free.pop_back();
+			}
+
+			if(m_timer.size() == (m_timer_free.size() + 1)) {
+				m_wheel_time = event_time();
+			}
+
+			orbit_event_timer &entry = m_timer[index];
+			entry.callback = callback;
+			entry.deadline = event_time() + timeout;
+			timer_insert(index);
+
+			if(entry.deadline < m_wheel_armed) {
+				timer_arm();
+			}
+
+			return (((orbit_timer_t) entry.generation << 32) | index);
+		}
+
+		void 
+		_orbit_event::timer_advance(
+			__in uint64_t now,
+			__out std::vector<orbit_timer_t> &expired
+			)
+		{
+			size_t level;
+			uint32_t index, next;
+
+			while(m_wheel_time <= now) {
+
+				if(!EVENT_WHEEL_INDEX(m_wheel_time, 0)) {
+
+					for(level = 1; level < EVENT_WHEEL_LEVEL; ++level) {
+						timer_cascade(level);
+
+						if(EVENT_WHEEL_INDEX(m_wheel_time, level)) {
+							break;
+						}
+					}
+				}
+
+				for(index = m_wheel[0][EVENT_WHEEL_INDEX(m_wheel_time, 0)]; index != EVENT_TIMER_NONE; 
+						index = next) {
+					orbit_event_timer &entry = m_timer[index];
+
+					next = entry.next;
+					timer_unlink(index);
+
+					if(entry.deadline > now) {
+						timer_insert(index);
+						continue;
+					}
+
+					entry.expired = true;
+					expired.push_back(((orbit_timer_t) entry.generation << 32) | index);
+				}
+
+				++m_wheel_time;
+
+				if(!m_wheel_count[0]) {
+
+					for(level = 1; (level < EVENT_WHEEL_LEVEL) && !m_wheel_count[level]; ++level);
+
+					if(level == EVENT_WHEEL_LEVEL) {
+						m_wheel_time = std::max(m_wheel_time, now + 1);
+					} else {
+						m_wheel_time = std::min(EVENT_WHEEL_CEIL(m_wheel_time, level), 
+							std::max(m_wheel_time, now + 1));
+					}
+				}
+			}
+		}
+
+		void 
+		_orbit_event::timer_arm(void)
+		{
+			size_t level, offset;
+			uint64_t deadline = TIMER_INVALID;
+			itimerspec value;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_wheel_count[0]) {
+
+				for(offset = 0; offset < EVENT_WHEEL_LEN; ++offset) {
+
+					if(m_wheel[0][EVENT_WHEEL_INDEX(m_wheel_time + offset, 0)] != EVENT_TIMER_NONE) {
+						deadline = m_wheel_time + offset;
+						break;
+					}
+				}
+			}
+
+			for(level = 1; level < EVENT_WHEEL_LEVEL; ++level) {
+
+				if(m_wheel_count[level]) {
+					deadline = std::min(deadline, EVENT_WHEEL_CEIL(m_wheel_time, level));
+					break;
+				}
+			}
+
+			memset(&value, 0, sizeof(value));
+			m_wheel_armed = deadline;
+
+			if(deadline != TIMER_INVALID) {
+				deadline = std::max(deadline, (uint64_t) 1);
+				value.it_value.tv_sec = deadline / EVENT_MSEC_PER_SEC;
+				value.it_value.tv_nsec = (deadline % EVENT_MSEC_PER_SEC) * EVENT_NSEC_PER_MSEC;
+			}
+
+			if(timerfd_settime(m_descriptor_timer, TFD_TIMER_ABSTIME, &value, NULL) < 0) {
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(timerfd_settime), strerror(errno));
+			}
+		}
+
+		void 
+		_orbit_event::timer_cascade(
+			__in size_t level
+			)
+		{
+			uint32_t index, next;
+
+			for(index = m_wheel[level][EVENT_WHEEL_INDEX(m_wheel_time, level)]; index != EVENT_TIMER_NONE;
+					index = next) {
+				next = m_timer[index].next;
+				timer_unlink(index);
+				timer_insert(index);
+			}
+		}
+
+		bool 
+		_orbit_event::timer_contains(
+			__in orbit_timer_t timer
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			return (timer_find(timer) != EVENT_TIMER_NONE);
+		}
+
+		size_t 
+		_orbit_event::timer_dispatch(void)
+		{
+			size_t result = 0;
+			uint32_t index;
+			orbit_timer_cb callback;
+			std::vector<orbit_timer_t> expired;
+			std::vector<orbit_timer_t>::iterator iter;
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				timer_advance(event_time(), expired);
+				timer_arm();
+			}
+
+			for(iter = expired.begin(); iter != expired.end(); ++iter) {
+
+				{
+					SERIALIZE_CALL_RECUR(m_lock);
+
+					index = timer_find(*iter);
+					if((index == EVENT_TIMER_NONE) || !m_timer[index].expired) {
+						continue;
+					}
+
+					callback = std::move(m_timer[index].callback);
+					timer_release(index);
+				}
+
+				callback(*iter);
+				++result;
+			}
+
+			return result;
+		}
+
+		uint32_t 
+		_orbit_event::timer_find(
+			__in orbit_timer_t timer
+			)
+		{
+			uint32_t index = (uint32_t) timer;
+
+			if((index >= m_timer.size()) 
+					|| (m_timer[index].generation != (uint32_t) (timer >> 32))
+					|| (m_timer[index].wheel == EVENT_TIMER_NONE)) {
+				return EVENT_TIMER_NONE;
+			}
+
+			return index;
+		}
+
+		void 
+		_orbit_event::timer_insert(
+			__in uint32_t index
+			)
+		{
+			size_t level = 0;
+			uint64_t deadline, delta;
+			orbit_event_timer &entry = m_timer[index];
+
+			deadline = std::max(entry.deadline, m_wheel_time);
+			delta = deadline - m_wheel_time;
+
+			if(delta >= EVENT_WHEEL_SPAN(EVENT_WHEEL_LEVEL)) {
+				deadline = m_wheel_time + EVENT_WHEEL_SPAN(EVENT_WHEEL_LEVEL) - 1;
+				delta = deadline - m_wheel_time;
+			}
+
+			while(delta >= EVENT_WHEEL_SPAN(level + 1)) {
+				++level;
+			}
+
+			entry.expired = false;
+			entry.wheel = (level * EVENT_WHEEL_LEN) + EVENT_WHEEL_INDEX(deadline, level);
+
+			uint32_t &head = m_wheel[level][EVENT_WHEEL_INDEX(deadline, level)];
+			entry.previous = EVENT_TIMER_NONE;
+			entry.next = head;
+
+			if(head != EVENT_TIMER_NONE) {
+				m_timer[head].previous = index;
+			}
+
+			head = index;
+			++m_wheel_count[level];
+		}
+
+		void 
+		_orbit_event::timer_release(
+			__in uint32_t index
+			)
+		{
+			orbit_event_timer &entry = m_timer[index];
+
+			entry.callback = nullptr;
+			entry.expired = false;
+			entry.wheel = EVENT_TIMER_NONE;
+
+			if(++entry.generation == EVENT_TIMER_NONE) {
+				entry.generation = 0;
+			}
+
+			m_timer_free.push_back(index);
+		}
+
+		void 
+		_orbit_event::timer_remove(
+			__in orbit_timer_t timer
+			)
+		{
+			uint32_t index;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			index = timer_find(timer);
+			if(index == EVENT_TIMER_NONE) {
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_TIMER_NOT_FOUND,
+					"%llu", (unsigned long long) timer);
+			}
+
+			timer_unlink(index);
+			timer_release(index);
+		}
+
+		void 
+		_orbit_event::timer_reset(
+			__in orbit_timer_t timer,
+			__in uint32_t timeout
+			)
+		{
+			uint32_t index;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			index = timer_find(timer);
+			if(index == EVENT_TIMER_NONE) {
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_TIMER_NOT_FOUND,
+					"%llu", (unsigned long long) timer);
+			}
+
+			timer_unlink(index);
+			m_timer[index].deadline = event_time() + timeout;
+			timer_insert(index);
+
+			if(m_timer[index].deadline < m_wheel_armed) {
+				timer_arm();
+			}
+		}
+
+		void 
+		_orbit_event::timer_unlink(
+			__in uint32_t index
+			)
+		{
+			orbit_event_timer &entry = m_timer[index];
+			size_t level = entry.wheel / EVENT_WHEEL_LEN;
+
+			if(entry.expired) {
+				entry.expired = false;
+				return;
+			}
+
+			if(entry.previous != EVENT_TIMER_NONE) {
+				m_timer[entry.previous].next = entry.next;
+			} else {
+				m_wheel[level][entry.wheel % EVENT_WHEEL_LEN] = entry.next;
+			}
+
+			if(entry.next != EVENT_TIMER_NONE) {
+				m_timer[entry.next].previous = entry.previous;
+			}
+
+			entry.next = EVENT_TIMER_NONE;
+			entry.previous = EVENT_TIMER_NONE;
+			--m_wheel_count[level];
+		}
+
+		std::string 
+		_orbit_event::to_string(
+			__in_opt bool verbose
+			)
+		{
+			size_t index = 1;
+			std::stringstream result;
+			std::map<int, std::pair<uint32_t, orbit_event_cb>>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << "[" << (m_initialized ? "INIT" : "UNINIT") << "] " 
+				<< ORBIT_EVENT_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			result << " [" << (m_running ? "RUN" : "STOP") << ", timer: " 
+				<< (m_timer.size() - m_timer_free.size()) << "]";
+
+			for(iter = m_map_descriptor.begin(); iter != m_map_descriptor.end(); ++index, ++iter) {
+				result << std::endl << "--- [" << index << "/" << m_map_descriptor.size() << "] "
+					<< iter->first << ", event: " << VALUE_AS_HEX(uint32_t, iter->second.first);
+			}
+
+			return CHECK_STR(result.str());
+		}
+
+		void 
+		_orbit_event::uninitialize(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			descriptor_close();
+			m_map_descriptor.clear();
+			m_post.clear();
+			m_running = false;
+			m_timer.clear();
+			m_timer_free.clear();
+			memset(m_wheel, 0xff, sizeof(m_wheel));
+			memset(m_wheel_count, 0, sizeof(m_wheel_count));
+			m_initialized = false;
+		}
+
+		void 
+		_orbit_event::wake(void)
+		{
+			uint64_t value = 1;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_EVENT_EXCEPTION(ORBIT_EVENT_EXCEPTION_UNINITIALIZE);
+			}
+
+			if((::write(m_descriptor_wake, &value, sizeof(value)) < 0)
+					&& (errno != EAGAIN)) {
+				THROW_ORBIT_EVENT_EXCEPTION_MESSAGE(ORBIT_EVENT_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::write), strerror(errno));
+			}
+		}
+	}
+}
@@ -0,0 +1,332 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <time.h>
+#include "../include/orbit.h"
+#include "../include/orbit_rate_type.h"
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define RATE_MSEC_PER_SEC 1000
+		#define RATE_NSEC_PER_USEC 1000
+		#define RATE_QUANTUM 0x5b4
+		#define RATE_TICK 10
+		#define RATE_USEC_PER_MSEC 1000
+		#define RATE_USEC_PER_SEC 1000000
+
+		static uint64_t 
+		rate_time(void)
+		{
+			timespec now;
+
+			clock_gettime(CLOCK_MONOTONIC, &now);
+
+			return ((uint64_t) now.tv_sec * RATE_USEC_PER_SEC) 
+				+ (now.tv_nsec / RATE_NSEC_PER_USEC);
+		}
+
+		_orbit_rate::_orbit_rate(
+			__in_opt uint64_t rate,
+			__in_opt _orbit_rate *parent
+			) :
+				m_active_last(0),
+				m_burst(rate),
+				m_parent(nullptr),
+				m_rate(rate),
+				m_time(rate_time()),
+				m_tokens(rate),
+				m_total(0)
+		{
+			set_parent(parent);
+		}
+
+		_orbit_rate::~_orbit_rate(void)
+		{
+			return;
+		}
+
+		size_t 
+		_orbit_rate::acquire(
+			__in size_t length
+			)
+		{
+			size_t result = length;
+			orbit_rate_ptr node = this;
+			const _orbit_rate *child = NULL;
+
+			if(!is_limited()) {
+
+				for(; node; node = node->parent()) {
+					node->m_total.fetch_add(length, std::memory_order_relaxed);
+				}
+
+				return result;
+			}
+
+			for(; node && result; child = node, node = node->parent()) {
+				result = node->quota(child, result);
+			}
+
+			if(result) {
+
+				for(node = this; node; node = node->parent()) {
+					node->take(result);
+				}
+			}
+
+			return result;
+		}
+
+		uint64_t 
+		_orbit_rate::burst(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_burst;
+		}
+
+		uint32_t 
+		_orbit_rate::delay(void)
+		{
+			uint32_t result = 0;
+			orbit_rate_ptr node = this;
+
+			for(; node; node = node->parent()) {
+				result = std::max(result, node->wait());
+			}
+
+			return result;
+		}
+
+		bool 
+		_orbit_rate::is_limited(void)
+		{
+			orbit_rate_ptr node = this;
+
+			for(; node; node = node->parent()) {
+
+				if(node->m_rate.load(std::memory_order_acquire)) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		_orbit_rate *
+		_orbit_rate::parent(void)
+		{
+			return m_parent.load(std::memory_order_acquire);
+		}
+
+		size_t 
+		_orbit_rate::quota(
+			__in const _orbit_rate *child,
+			__in size_t length
+			)
+		{
+			size_t result;
+
+			if(!m_rate.load(std::memory_order_acquire)) {
+				return length;
+			}
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			refill();
+
+			if(child) {
+				m_active.insert(child);
+			}
+
+			if(!m_rate) {
+				return length;
+			} else if(m_tokens <= 0) {
+				return 0;
+			}
+
+			result = m_tokens;
+
+			if(child && (m_active_last > 1)) {
+				result = std::max(result / m_active_last, std::min(result, (size_t) RATE_QUANTUM));
+			}
+
+			return std::min(result, length);
+		}
+
+		uint64_t 
+		_orbit_rate::rate(void)
+		{
+			return m_rate.load(std::memory_order_acquire);
+		}
+
+		void 
+		_orbit_rate::refill(void)
+		{
+			uint64_t elapsed, now = rate_time();
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			elapsed = now - m_time;
+			if(elapsed < (RATE_TICK * RATE_USEC_PER_MSEC)) {
+				return;
+			}
+
+			if(m_rate) {
+				m_tokens = std::min((double) m_burst, m_tokens 
+					+ (((double) elapsed * m_rate) / RATE_USEC_PER_SEC));
+			}
+
+			m_active_last = m_active.size();
+			m_active.clear();
+			m_time = now;
+		}
+
+		void 
+		_orbit_rate::release(
+			__in size_t length
+			)
+		{
+			orbit_rate_ptr node = this;
+
+			for(; node; node = node->parent()) {
+				node->refund(length);
+			}
+		}
+
+		void 
+		_orbit_rate::refund(
+			__in size_t length
+			)
+		{
+			uint64_t total = m_total.load(std::memory_order_relaxed);
+
+			while(!m_total.compare_exchange_weak(total, total - std::min((uint64_t) length, total), 
+					std::memory_order_relaxed)) {
+				continue;
+			}
+
+			if(m_rate.load(std::memory_order_acquire)) {
+				SERIALIZE_CALL_RECUR(m_lock);
+				m_tokens = std::min((int64_t) m_burst, (int64_t) (m_tokens + length));
+			}
+		}
+
+		void 
+		_orbit_rate::set_parent(
+			__in_opt _orbit_rate *parent
+			)
+		{
+			orbit_rate_ptr node = parent;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			for(; node; node = node->parent()) {
+
+				if(node == this) {
+					THROW_ORBIT_RATE_EXCEPTION_MESSAGE(ORBIT_RATE_EXCEPTION_PARENT,
+						"%p", parent);
+				}
+			}
+
+			m_parent = parent;
+		}
+
+		void 
+		_orbit_rate::set_rate(
+			__in uint64_t rate,
+			__in_opt uint64_t burst
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			m_burst = burst ? burst : rate;
+			m_rate = rate;
+			m_time = rate_time();
+			m_tokens = m_burst;
+		}
+
+		void 
+		_orbit_rate::take(
+			__in size_t length
+			)
+		{
+			m_total.fetch_add(length, std::memory_order_relaxed);
+
+			if(m_rate.load(std::memory_order_acquire)) {
+				SERIALIZE_CALL_RECUR(m_lock);
+				m_tokens -= length;
+			}
+		}
+
+		std::string 
+		_orbit_rate::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << ORBIT_RATE_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			if(m_rate) {
+				result << " rate: " << m_rate << ", burst: " << m_burst << ", tok: " << m_tokens;
+			} else {
+				result << " rate: UNLIMITED";
+			}
+
+			result << ", total: " << m_total;
+
+			return CHECK_STR(result.str());
+		}
+
+		uint64_t 
+		_orbit_rate::total(void)
+		{
+			return m_total.load(std::memory_order_relaxed);
+		}
+
+		uint32_t 
+		_orbit_rate::wait(void)
+		{
+			uint32_t result = 0;
+
+			if(!m_rate.load(std::memory_order_acquire)) {
+				return result;
+			}
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			refill();
+
+			if(m_rate && (m_tokens <= 0)) {
+				result = ((((uint64_t) (1 - m_tokens)) * RATE_MSEC_PER_SEC) + m_rate - 1) / m_rate;
+				result = std::max(result, (uint32_t) RATE_TICK);
+			}
+
+			return result;
+		}
+	}
+}
@@ -0,0 +1,455 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <string.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include "../include/orbit.h"
+#include "../include/orbit_resolver_type.h"
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define RESOLVER_CACHE_MAX 0x1000
+		#define RESOLVER_MSEC_PER_SEC 1000
+		#define RESOLVER_TTL 300
+		#define RESOLVER_WORKER_COUNT 4
+
+		static uint64_t 
+		resolver_time(void)
+		{
+			return std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		orbit_resolver_ptr orbit_resolver::m_instance = NULL;
+
+		_orbit_resolver::_orbit_resolver(void) :
+			m_initialized(false),
+			m_ttl(RESOLVER_TTL)
+		{
+			std::atexit(orbit_resolver::_delete);
+		}
+
+		_orbit_resolver::~_orbit_resolver(void)
+		{
+
+			if(m_initialized) {
+				uninitialize();
+			}
+		}
+
+		void 
+		_orbit_resolver::_delete(void)
+		{
+
+			if(orbit_resolver::m_instance) {
+				delete orbit_resolver::m_instance;
+				orbit_resolver::m_instance = NULL;
+			}
+		}
+
+		orbit_resolver_ptr 
+		_orbit_resolver::acquire(void)
+		{
+
+			if(!orbit_resolver::m_instance) {
+
+				orbit_resolver::m_instance = new orbit_resolver;
+				if(!orbit_resolver::m_instance) {
+					THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_ALLOCATION);
+				}
+			}
+
+			return orbit_resolver::m_instance;
+		}
+
+		void 
+		_orbit_resolver::clear(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE);
+			}
+
+			m_map_cache.clear();
+		}
+
+		bool 
+		_orbit_resolver::contains(
+			__in const std::string &host
+			)
+		{
+			std::map<std::string, std::pair<uint64_t, orbit_resolver_address_t>>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE);
+			}
+
+			iter = m_map_cache.find(host);
+
+			return ((iter != m_map_cache.end()) && (iter->second.first > resolver_time()));
+		}
+
+		void 
+		_orbit_resolver::initialize(void)
+		{
+			size_t iter = 0;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_initialized) {
+				THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_INITIALIZE);
+			}
+
+			m_initialized = true;
+			m_map_cache.clear();
+			m_map_pending.clear();
+			m_queue.clear();
+
+			for(; iter < RESOLVER_WORKER_COUNT; ++iter) {
+				m_worker.push_back(std::thread(&_orbit_resolver::worker, this));
+			}
+		}
+
+		bool 
+		_orbit_resolver::is_allocated(void)
+		{
+			return (orbit_resolver::m_instance != NULL);
+		}
+
+		bool 
+		_orbit_resolver::is_initialized(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_initialized;
+		}
+
+		bool 
+		_orbit_resolver::lookup(
+			__in const std::string &host,
+			__out orbit_resolver_address_t &address
+			)
+		{
+			sockaddr_storage entry;
+			std::map<std::string, std::pair<uint64_t, orbit_resolver_address_t>>::iterator iter;
+
+			memset(&entry, 0, sizeof(entry));
+
+			if(inet_pton(AF_INET, host.c_str(), &((sockaddr_in *) &entry)->sin_addr) == 1) {
+				entry.ss_family = AF_INET;
+				address.assign(1, entry);
+				return true;
+			} else if(inet_pton(AF_INET6, host.c_str(), &((sockaddr_in6 *) &entry)->sin6_addr) == 1) {
+				entry.ss_family = AF_INET6;
+				address.assign(1, entry);
+				return true;
+			}
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE);
+			}
+
+			iter = m_map_cache.find(host);
+			if((iter == m_map_cache.end()) || (iter->second.first <= resolver_time())) {
+				return false;
+			}
+
+			address = iter->second.second;
+
+			return true;
+		}
+
+		orbit_resolver_address_t 
+		_orbit_resolver::resolve(
+			__in const std::string &host
+			)
+		{
+			int error;
+			orbit_resolver_address_t result;
+
+			result = resolve(host, error);
+			if((error == EAI_SYSTEM) && !is_initialized()) {
+				THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE);
+			} else if(error) {
+				THROW_ORBIT_RESOLVER_EXCEPTION_MESSAGE(ORBIT_RESOLVER_EXCEPTION_INTERNAL,
+					"[%s] %s: %s", CONCAT_STR(getaddrinfo), CHECK_STR(host), gai_strerror(error));
+			}
+
+			return result;
+		}
+
+		orbit_resolver_address_t 
+		_orbit_resolver::resolve(
+			__in const std::string &host,
+			__out int &error
+			)
+		{
+			std::pair<int, orbit_resolver_address_t> result;
+			std::shared_ptr<std::promise<std::pair<int, orbit_resolver_address_t>>> promise;
+
+			error = 0;
+
+			if(lookup(host, result.second)) {
+				return result.second;
+			}
+
+			if(!is_initialized()) {
+				error = EAI_SYSTEM;
+				return result.second;
+			}
+
+			promise = std::make_shared<std::promise<std::pair<int, orbit_resolver_address_t>>>();
+			std::future<std::pair<int, orbit_resolver_address_t>> future = promise->get_future();
+
+			resolve(host, [promise](const std::string &host, int error, 
+					const orbit_resolver_address_t &address) {
+				UNREFERENCE_PARAM(host);
+				promise->set_value(std::pair<int, orbit_resolver_address_t>(error, address));
+			});
+
+			result = future.get();
+			error = result.first;
+
+			return result.second;
+		}
+
+		void 
+		_orbit_resolver::resolve(
+			__in const std::string &host,
+			__in const orbit_resolver_cb &complete
+			)
+		{
+			orbit_resolver_address_t address;
+			std::map<std::string, std::vector<orbit_resolver_cb>>::iterator iter;
+
+			if(lookup(host, address)) {
+				complete(host, 0, address);
+				return;
+			}
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE);
+			}
+
+			iter = m_map_pending.find(host);
+			if(iter == m_map_pending.end()) {
+				m_map_pending[host].push_back(complete);
+				m_queue.push_back(host);
+				m_condition.notify_one();
+			} else {
+				iter->second.push_back(complete);
+			}
+		}
+
+		void 
+		_orbit_resolver::set_ttl(
+			__in uint32_t ttl
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			m_ttl = ttl;
+		}
+
+		size_t 
+		_orbit_resolver::size(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE);
+			}
+
+			return m_map_cache.size();
+		}
+
+		std::string 
+		_orbit_resolver::to_string(
+			__in_opt bool verbose
+			)
+		{
+			size_t index = 1;
+			std::stringstream result;
+			std::map<std::string, std::pair<uint64_t, orbit_resolver_address_t>>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << "[" << (m_initialized ? "INIT" : "UNINIT") << "] " 
+				<< ORBIT_RESOLVER_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			result << " [ttl: " << m_ttl << ", pend: " << m_map_pending.size() << "]";
+
+			for(iter = m_map_cache.begin(); iter != m_map_cache.end(); ++index, ++iter) {
+				result << std::endl << "--- [" << index << "/" << m_map_cache.size() << "] "
+					<< CHECK_STR(iter->first) << ", addr: " << iter->second.second.size();
+			}
+
+			return CHECK_STR(result.str());
+		}
+
+		uint32_t 
+		_orbit_resolver::ttl(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_ttl;
+		}
+
+		void 
+		_orbit_resolver::uninitialize(void)
+		{
+			std::vector<std::thread> worker;
+			std::vector<std::thread>::iterator iter;
+			std::map<std::string, std::vector<orbit_resolver_cb>> pending;
+			std::map<std::string, std::vector<orbit_resolver_cb>>::iterator entry;
+			std::vector<orbit_resolver_cb>::iterator complete;
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				if(!m_initialized) {
+					THROW_ORBIT_RESOLVER_EXCEPTION(ORBIT_RESOLVER_EXCEPTION_UNINITIALIZE);
+				}
+
+				m_initialized = false;
+				m_condition.notify_all();
+				worker.swap(m_worker);
+			}
+
+			for(iter = worker.begin(); iter != worker.end(); ++iter) {
+				iter->join();
+			}
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				pending.swap(m_map_pending);
+				m_map_cache.clear();
+				m_queue.clear();
+			}
+
+			for(entry = pending.begin(); entry != pending.end(); ++entry) {
+
+				for(complete = entry->second.begin(); complete != entry->second.end(); ++complete) {
+					(*complete)(entry->first, EAI_CANCELED, orbit_resolver_address_t());
+				}
+			}
+		}
+
+		void 
+		_orbit_resolver::worker(void)
+		{
+			int error;
+			std::string host;
+			addrinfo hints, *information, *iter;
+			orbit_resolver_address_t address;
+			std::vector<orbit_resolver_cb> complete;
+			std::vector<orbit_resolver_cb>::iterator entry;
+			std::map<std::string, std::pair<uint64_t, orbit_resolver_address_t>>::iterator cache;
+			std::unique_lock<std::recursive_mutex> lock(m_lock);
+
+			memset(&hints, 0, sizeof(hints));
+			hints.ai_family = AF_UNSPEC;
+			hints.ai_socktype = SOCK_STREAM;
+
+			for(;;) {
+				m_condition.wait(lock, [this]() {
+						return (!m_initialized || !m_queue.empty());
+					});
+
+				if(!m_initialized) {
+					break;
+				}
+
+				host = m_queue.front();
+				m_queue.pop_front();
+				lock.unlock();
+
+				address.clear();
+				information = NULL;
+
+				error = getaddrinfo(host.c_str(), NULL, &hints, &information);
+				if(!error) {
+
+					for(iter = information; iter; iter = iter->ai_next) {
+
+						if((iter->ai_family == AF_INET) || (iter->ai_family == AF_INET6)) {
+							address.push_back(sockaddr_storage());
+							memset(&address.back(), 0, sizeof(sockaddr_storage));
+							memcpy(&address.back(), iter->ai_addr, iter->ai_addrlen);
+						}
+					}
+
+					freeaddrinfo(information);
+
+					if(address.empty()) {
+						error = EAI_NODATA;
+					}
+				}
+
+				lock.lock();
+
+				if(!error) {
+
+					if(m_map_cache.size() >= RESOLVER_CACHE_MAX) {
+
+						for(cache = m_map_cache.begin(); cache != m_map_cache.end();) {
+
+							if(cache->second.first <= resolver_time()) {
+								cache = m_map_cache.erase(cache);
+							} else {
+								++cache;
+							}
+						}
+
+						if(m_map_cache.size() >= RESOLVER_CACHE_MAX) {
+							m_map_cache.erase(m_map_cache.begin());
+						}
+					}
+
+					m_map_cache[host] = std::pair<uint64_t, orbit_resolver_address_t>(
+						resolver_time() + ((uint64_t) m_ttl * RESOLVER_MSEC_PER_SEC), address);
+				}
+
+				complete.swap(m_map_pending[host]);
+				m_map_pending.erase(host);
+				lock.unlock();
+
+				for(entry = complete.begin(); entry != complete.end(); ++entry) {
+					(*entry)(host, error, address);
+				}
+
+				complete.clear();
+				lock.lock();
+			}
+		}
+	}
+}
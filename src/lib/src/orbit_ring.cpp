@@ -0,0 +1,291 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "../include/orbit.h"
+#include "../include/orbit_ring_type.h"
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define RING_NAME "orbit_ring"
+
+		_orbit_ring::_orbit_ring(void) :
+			m_base(NULL),
+			m_capacity(0),
+			m_head(0),
+			m_tail(0)
+		{
+			return;
+		}
+
+		_orbit_ring::_orbit_ring(
+			__in _orbit_ring &&other
+			) noexcept :
+				m_base(NULL),
+				m_capacity(0),
+				m_head(0),
+				m_tail(0)
+		{
+			*this = std::move(other);
+		}
+
+		_orbit_ring::~_orbit_ring(void)
+		{
+
+			if(m_base) {
+				uninitialize();
+			}
+		}
+
+		_orbit_ring &
+		_orbit_ring::operator=(
+			__in _orbit_ring &&other
+			) noexcept
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(this != &other) {
+				std::lock_guard<std::recursive_mutex> lock(other.m_lock);
+
+				if(m_base) {
+					munmap(m_base, m_capacity * 2);
+				}
+
+				m_base = other.m_base;
+				m_capacity = other.m_capacity;
+				m_head = other.m_head;
+				m_tail = other.m_tail;
+				other.m_base = NULL;
+				other.m_capacity = 0;
+				other.m_head = 0;
+				other.m_tail = 0;
+			}
+
+			return *this;
+		}
+
+		size_t 
+		_orbit_ring::capacity(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_capacity;
+		}
+
+		void 
+		_orbit_ring::clear(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			m_head = 0;
+			m_tail = 0;
+		}
+
+		void 
+		_orbit_ring::commit(
+			__in size_t length
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_base) {
+				THROW_ORBIT_RING_EXCEPTION(ORBIT_RING_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(length > space()) {
+				THROW_ORBIT_RING_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_LENGTH,
+					"%zu/%zu", length, space());
+			}
+
+			m_tail += length;
+		}
+
+		void 
+		_orbit_ring::consume(
+			__in size_t length
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_base) {
+				THROW_ORBIT_RING_EXCEPTION(ORBIT_RING_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(length > (m_tail - m_head)) {
+				THROW_ORBIT_RING_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_LENGTH,
+					"%zu/%zu", length, (size_t) (m_tail - m_head));
+			}
+
+			m_head += length;
+			if(m_head == m_tail) {
+				m_head = 0;
+				m_tail = 0;
+			}
+		}
+
+		void 
+		_orbit_ring::initialize(
+			__in size_t capacity
+			)
+		{
+			int descriptor;
+			uint8_t *base;
+			size_t page = sysconf(_SC_PAGESIZE);
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_base) {
+				THROW_ORBIT_RING_EXCEPTION(ORBIT_RING_EXCEPTION_INITIALIZE);
+			}
+
+			if(!capacity) {
+				THROW_ORBIT_RING_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_CAPACITY,
+					"%zu", capacity);
+			}
+
+			capacity = ((capacity + page - 1) / page) * page;
+
+			descriptor = memfd_create(RING_NAME, MFD_CLOEXEC);
+			if(descriptor < 0) {
+				THROW_ORBIT_RING_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(memfd_create), strerror(errno));
+			}
+
+			if(ftruncate(descriptor, capacity) < 0) {
+				::close(descriptor);
+				THROW_ORBIT_RING_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(ftruncate), strerror(errno));
+			}
+
+			base = (uint8_t *) mmap(NULL, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if(base == MAP_FAILED) {
+				::close(descriptor);
+				THROW_ORBIT_RING_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(mmap), strerror(errno));
+			}
+
+			if((mmap(base, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, 
+					descriptor, 0) == MAP_FAILED)
+					|| (mmap(base + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, 
+					descriptor, 0) == MAP_FAILED)) {
+				munmap(base, capacity * 2);
+				::close(descriptor);
+				THROW_ORBIT_RING_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(mmap), strerror(errno));
+			}
+
+			::close(descriptor);
+			m_base = base;
+			m_capacity = capacity;
+			m_head = 0;
+			m_tail = 0;
+		}
+
+		bool 
+		_orbit_ring::is_initialized(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return (m_base != NULL);
+		}
+
+		size_t 
+		_orbit_ring::length(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return (m_tail - m_head);
+		}
+
+		const uint8_t *
+		_orbit_ring::peek(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_base) {
+				THROW_ORBIT_RING_EXCEPTION(ORBIT_RING_EXCEPTION_UNINITIALIZE);
+			}
+
+			return (m_base + (m_head % m_capacity));
+		}
+
+		uint8_t *
+		_orbit_ring::reserve(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_base) {
+				THROW_ORBIT_RING_EXCEPTION(ORBIT_RING_EXCEPTION_UNINITIALIZE);
+			}
+
+			return (m_base + (m_tail % m_capacity));
+		}
+
+		size_t 
+		_orbit_ring::space(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return (m_capacity - (m_tail - m_head));
+		}
+
+		std::string 
+		_orbit_ring::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << "[" << (m_base ? "INIT" : "UNINIT") << "] " 
+				<< ORBIT_RING_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			if(m_base) {
+				result << " len: " << (m_tail - m_head) << "/" << m_capacity;
+			}
+
+			return CHECK_STR(result.str());
+		}
+
+		void 
+		_orbit_ring::uninitialize(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_base) {
+				THROW_ORBIT_RING_EXCEPTION(ORBIT_RING_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(munmap(m_base, m_capacity * 2) < 0) {
+				THROW_ORBIT_RING_EXCEPTION_MESSAGE(ORBIT_RING_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(munmap), strerror(errno));
+			}
+
+			m_base = NULL;
+			m_capacity = 0;
+			m_head = 0;
+			m_tail = 0;
+		}
+	}
+}
@@ -0,0 +1,392 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "../include/orbit.h"
+#include "../include/orbit_shard_type.h"
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define SHARD_CORE_INVALID (-1)
+
+		_orbit_shard::_orbit_shard(
+			__in size_t index,
+			__in uint32_t range,
+			__in int core
+			) :
+				m_core(core),
+				m_descriptor_queue(0),
+				m_factory(new orbit_socket_factory),
+				m_failed(0),
+				m_index(index),
+				m_initialized(false),
+				m_queue_head(NULL),
+				m_queue_tail(new orbit_shard_node),
+				m_range(range),
+				m_signalled(false)
+		{
+			m_queue_tail->next = NULL;
+			m_queue_head = m_queue_tail;
+		}
+
+		_orbit_shard::~_orbit_shard(void)
+		{
+
+			if(m_initialized) {
+				uninitialize();
+			}
+
+			delete m_factory;
+			delete m_queue_tail;
+		}
+
+		orbit_uid 
+		_orbit_shard::accept(
+			__in const orbit_uid &uid
+			)
+		{
+			return generate([this, &uid](void) {
+					return std::vector<orbit_uid>(1, m_factory->accept(uid));
+				}).front();
+		}
+
+		orbit_socket_factory_ptr 
+		_orbit_shard::acquire_factory(void)
+		{
+			return m_factory;
+		}
+
+		int 
+		_orbit_shard::core(void)
+		{
+			return m_core;
+		}
+
+		void 
+		_orbit_shard::drain(void)
+		{
+			uint64_t value;
+			orbit_shard_cb callback;
+
+			if((::read(m_descriptor_queue, &value, sizeof(value)) < 0)
+					&& (errno != EAGAIN)) {
+				THROW_ORBIT_SHARD_EXCEPTION_MESSAGE(ORBIT_SHARD_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::read), strerror(errno));
+			}
+
+			m_signalled.store(false);
+
+			while(pop(callback)) {
+
+				try {
+					callback();
+				} catch(...) {
+					++m_failed;
+				}
+
+				callback = nullptr;
+			}
+		}
+
+		orbit_event &
+		_orbit_shard::event(void)
+		{
+			return *m_factory->acquire_event();
+		}
+
+		size_t 
+		_orbit_shard::failed(void)
+		{
+			return m_failed;
+		}
+
+		std::vector<orbit_uid> 
+		_orbit_shard::generate(
+			__in const std::function<std::vector<orbit_uid>(void)> &create
+			)
+		{
+			uint32_t previous;
+			std::vector<orbit_uid> result;
+			orbit_uid_factory_ptr factory = orbit_uid_factory::acquire();
+
+			if(!m_initialized) {
+				THROW_ORBIT_SHARD_EXCEPTION(ORBIT_SHARD_EXCEPTION_UNINITIALIZE);
+			}
+
+			previous = factory->range_select(m_range);
+
+			try {
+				result = create();
+			} catch(...) {
+				factory->range_select(previous);
+				throw;
+			}
+
+			factory->range_select(previous);
+
+			return result;
+		}
+
+		std::vector<orbit_uid> 
+		_orbit_shard::generate_listen(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in_opt size_t count,
+			__in_opt int backlog
+			)
+		{
+			return generate([this, &host, port, count, backlog](void) {
+					return m_factory->generate_listen(host, port, count, backlog);
+				});
+		}
+
+		orbit_uid 
+		_orbit_shard::generate_tcp(
+			__in_opt const std::string &host,
+			__in_opt uint16_t port
+			)
+		{
+			return generate([this, &host, port](void) {
+					return std::vector<orbit_uid>(1, m_factory->generate_tcp(host, port));
+				}).front();
+		}
+
+		orbit_uid 
+		_orbit_shard::generate_udp(
+			__in_opt const std::string &host,
+			__in_opt uint16_t port
+			)
+		{
+			return generate([this, &host, port](void) {
+					return std::vector<orbit_uid>(1, m_factory->generate_udp(host, port));
+				}).front();
+		}
+
+		size_t 
+		_orbit_shard::index(void)
+		{
+			return m_index;
+		}
+
+		void 
+		_orbit_shard::initialize(void)
+		{
+			cpu_set_t set;
+			int result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_initialized) {
+				THROW_ORBIT_SHARD_EXCEPTION(ORBIT_SHARD_EXCEPTION_INITIALIZE);
+			}
+
+			m_factory->initialize();
+
+			m_descriptor_queue = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if(m_descriptor_queue < 0) {
+				m_descriptor_queue = 0;
+				m_factory->uninitialize();
+				THROW_ORBIT_SHARD_EXCEPTION_MESSAGE(ORBIT_SHARD_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(eventfd), strerror(errno));
+			}
+
+			m_factory->acquire_event()->add(m_descriptor_queue, ORBIT_EVENT_READ, 
+				[this](int, uint32_t) {
+					drain();
+				});
+
+			m_failed = 0;
+			m_signalled = false;
+			m_initialized = true;
+			m_thread = std::thread(&_orbit_shard::run, this);
+
+			if(m_core != SHARD_CORE_INVALID) {
+				CPU_ZERO(&set);
+				CPU_SET(m_core, &set);
+
+				result = pthread_setaffinity_np(m_thread.native_handle(), sizeof(set), &set);
+				if(result) {
+					uninitialize();
+					THROW_ORBIT_SHARD_EXCEPTION_MESSAGE(ORBIT_SHARD_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(pthread_setaffinity_np), strerror(result));
+				}
+			}
+		}
+
+		bool 
+		_orbit_shard::is_current(void)
+		{
+			return (std::this_thread::get_id() == m_thread.get_id());
+		}
+
+		bool 
+		_orbit_shard::is_initialized(void)
+		{
+			return m_initialized;
+		}
+
+		bool 
+		_orbit_shard::pop(
+			__out orbit_shard_cb &callback
+			)
+		{
+			orbit_shard_node_ptr next, tail = m_queue_tail;
+
+			next = tail->next.load(std::memory_order_acquire);
+			if(!next) {
+				return false;
+			}
+
+			callback = std::move(next->callback);
+			next->callback = nullptr;
+			m_queue_tail = next;
+			delete tail;
+
+			return true;
+		}
+
+		void 
+		_orbit_shard::post(
+			__in const orbit_shard_cb &callback
+			)
+		{
+			uint64_t value = 1;
+			orbit_shard_node_ptr node, previous;
+
+			if(!m_initialized) {
+				THROW_ORBIT_SHARD_EXCEPTION(ORBIT_SHARD_EXCEPTION_UNINITIALIZE);
+			}
+
+			node = new orbit_shard_node;
+			node->next.store(NULL, std::memory_order_relaxed);
+			node->callback = callback;
+
+			previous = m_queue_head.exchange(node, std::memory_order_acq_rel);
+			previous->next.store(node, std::memory_order_release);
+
+			if(!m_signalled.exchange(true)) {
+
+				if((::write(m_descriptor_queue, &value, sizeof(value)) < 0)
+						&& (errno != EAGAIN)) {
+					THROW_ORBIT_SHARD_EXCEPTION_MESSAGE(ORBIT_SHARD_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(::write), strerror(errno));
+				}
+			}
+		}
+
+		uint32_t 
+		_orbit_shard::range(void)
+		{
+			return m_range;
+		}
+
+		void 
+		_orbit_shard::run(void)
+		{
+			orbit_event_ptr event = m_factory->acquire_event();
+
+			orbit_uid_factory::acquire()->range_select(m_range);
+
+			for(;;) {
+
+				try {
+					event->run();
+					break;
+				} catch(...) {
+					++m_failed;
+
+					if(!event->is_running()) {
+						break;
+					}
+				}
+			}
+		}
+
+		std::string 
+		_orbit_shard::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << "[" << (m_initialized ? "INIT" : "UNINIT") << "] " 
+				<< ORBIT_SHARD_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			result << " [" << m_index << ", range: " << m_range << ", core: ";
+
+			if(m_core != SHARD_CORE_INVALID) {
+				result << m_core;
+			} else {
+				result << "ANY";
+			}
+
+			result << ", failed: " << m_failed << "]";
+
+			if(m_initialized) {
+				result << std::endl << m_factory->acquire_event()->to_string(verbose)
+					<< std::endl << m_factory->to_string(verbose);
+			}
+
+			return CHECK_STR(result.str());
+		}
+
+		void 
+		_orbit_shard::uninitialize(void)
+		{
+			orbit_shard_cb callback;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_SHARD_EXCEPTION(ORBIT_SHARD_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(m_thread.joinable()) {
+				post([this](void) {
+						m_factory->acquire_event()->stop();
+					});
+
+				m_thread.join();
+			}
+
+			m_initialized = false;
+
+			while(pop(callback));
+
+			m_factory->uninitialize();
+
+			if(m_descriptor_queue) {
+				::close(m_descriptor_queue);
+				m_descriptor_queue = 0;
+			}
+		}
+	}
+}
@@ -17,9 +17,16 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <fcntl.h>
+#include <poll.h>
 #include <string.h>
 #include <unistd.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/errqueue.h>
+#include <sys/sendfile.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include "../include/orbit.h"
@@ -29,8 +36,16 @@ namespace ORBIT {
 
 	namespace COMPONENT {
 
-		#define SOCKET_BLOCK_READ_LEN 0x2000
 		#define SOCKET_ADDR_STR_MAX 80
+		#define SOCKET_BATCH_LEN 0x20
+		#define SOCKET_BATCH_MAX 0x400
+		#define SOCKET_DATAGRAM_LEN 0x1000
+		#define SOCKET_FRAME_PREFIX_LEN sizeof(uint32_t)
+		#define SOCKET_SENDFILE_LEN 0x7ffff000
+		#define SOCKET_CONNECT_DELAY 250
+		#define SOCKET_WRITE_VECTOR_LEN 0x40
+		#define SOCKET_ZEROCOPY_BATCH 0x20
+		#define SOCKET_ZEROCOPY_TIMEOUT 1000
 
 		static const std::string ORBIT_SOCKET_TYPE_STR[] = {
 			"NONE", "TCP", "UDP",
@@ -52,32 +67,75 @@ namespace ORBIT {
 			__in_opt const std::string &host,
 			__in_opt uint16_t port
 			) :
+				m_batch(SOCKET_BATCH_LEN),
+				m_blocking(true),
+				m_connect_error(0),
+				m_connect_event(NULL),
+				m_connect_next(0),
+				m_connect_timer(TIMER_INVALID),
+				m_connect_timeout(0),
+				m_corked(false),
 				m_host(host),
-				m_information(NULL),
+				m_listening(false),
 				m_port(port),
+				m_rate_events(0),
+				m_rate_read(NULL),
+				m_rate_timer(TIMER_INVALID),
+				m_rate_write(NULL),
 				m_socket(0),
-				m_type(ORBIT_SOCKET_TYPE_NONE)
+				m_type(ORBIT_SOCKET_TYPE_NONE),
+				m_watch(NULL),
+				m_zerocopy(false),
+				m_zerocopy_next(0)
 		{
 			memset(&m_address_4, 0, sizeof(sockaddr_in));
 			memset(&m_address_6, 0, sizeof(sockaddr_in6));
 		}
 
 		_orbit_socket::_orbit_socket(
-			__in const _orbit_socket &other
-			) :
-				m_host(other.m_host),
-				m_information(NULL),
-				m_port(other.m_port),
+			__in _orbit_socket &&other
+			) noexcept :
+				orbit_uid_class(std::move(other)),
+				m_batch(SOCKET_BATCH_LEN),
+				m_blocking(true),
+				m_connect_error(0),
+				m_connect_event(NULL),
+				m_connect_next(0),
+				m_connect_timer(TIMER_INVALID),
+				m_connect_timeout(0),
+				m_corked(false),
+				m_listening(false),
+				m_port(0),
+				m_rate_events(0),
+				m_rate_read(NULL),
+				m_rate_timer(TIMER_INVALID),
+				m_rate_write(NULL),
 				m_socket(0),
-				m_type(ORBIT_SOCKET_TYPE_NONE)
+				m_type(ORBIT_SOCKET_TYPE_NONE),
+				m_watch(NULL),
+				m_zerocopy(false),
+				m_zerocopy_next(0)
 		{
 			memset(&m_address_4, 0, sizeof(sockaddr_in));
 			memset(&m_address_6, 0, sizeof(sockaddr_in6));
+			swap(other);
 		}
 
 		_orbit_socket::~_orbit_socket(void)
 		{
 
+			if(m_connect_guard) {
+				std::lock_guard<std::mutex> lock(m_connect_guard->lock);
+
+				m_connect_guard->handle.reset();
+				m_connect_guard->pinned = false;
+				m_connect_guard->socket = NULL;
+			}
+
+			if(is_connecting()) {
+				connect_cancel();
+			}
+
 			if(is_open()) {
 				close();
 			}
@@ -85,33 +143,13 @@ namespace ORBIT {
 
 		_orbit_socket &
 		_orbit_socket::operator=(
-			__in const _orbit_socket &other
-			)
+			__in _orbit_socket &&other
+			) noexcept
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 
 			if(this != &other) {
-
-				if(m_socket) {
-
-					if(::close(m_socket) < 0) {
-						THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-							"[%s] %s", CONCAT_STR(::close), strerror(errno));
-					}
-
-					m_socket = 0;
-				}
-
-				if(m_information) {
-					freeaddrinfo(m_information);
-					m_information = NULL;
-				}
-
-				memset(&m_address_4, 0, sizeof(sockaddr_in));
-				memset(&m_address_6, 0, sizeof(sockaddr_in6));
-				m_host = other.m_host;
-				m_port = other.m_port;
-				m_type = ORBIT_SOCKET_TYPE_NONE;
+				orbit_uid_class::operator=(std::move(other));
+				swap(other);
 			}
 
 			return *this;
@@ -120,6 +158,7 @@ namespace ORBIT {
 		std::string 
 		_orbit_socket::address(void)
 		{
+			int family;
 			void *addr = NULL;
 			std::string result;
 
@@ -129,345 +168,2399 @@ namespace ORBIT {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
 			}
 
-			if(m_information) {
-
-				switch(m_information->ai_family) {
-					case AF_INET:
-						addr = &((sockaddr_in *) m_information->ai_addr)->sin_addr;
-						break;
-					case AF_INET6:
-						addr = &((sockaddr_in6 *) m_information->ai_addr)->sin6_addr;
-						break;
-					default:
-						THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE_INET,
-							"%i", m_information->ai_family);
-				}
+			if(m_address_4.sin_family == AF_INET) {
+				addr = &m_address_4.sin_addr;
+				family = AF_INET;
+			} else if(m_address_6.sin6_family == AF_INET6) {
+				addr = &m_address_6.sin6_addr;
+				family = AF_INET6;
+			}
 
+			if(addr) {
 				result.resize(SOCKET_ADDR_STR_MAX);
 
-				if(!inet_ntop(m_information->ai_family, addr, (char *) &result[0], 
-						SOCKET_ADDR_STR_MAX)) {
+				if(!inet_ntop(family, addr, (char *) &result[0], SOCKET_ADDR_STR_MAX)) {
 					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
 						"[%s] %s", CONCAT_STR(inet_ntop), strerror(errno));
 				}
+
+				result.resize(strlen(result.c_str()));
 			}
 
 			return CHECK_STR(result);
 		}
 
+		sockaddr *
+		_orbit_socket::address_set(
+			__in const sockaddr *address,
+			__out socklen_t &length
+			)
+		{
+			sockaddr *result = NULL;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			memset(&m_address_4, 0, sizeof(sockaddr_in));
+			memset(&m_address_6, 0, sizeof(sockaddr_in6));
+
+			switch(address->sa_family) {
+				case AF_INET:
+					memcpy(&m_address_4.sin_addr, &((sockaddr_in *) address)->sin_addr, 
+						sizeof(m_address_4.sin_addr));
+					m_address_4.sin_family = AF_INET;
+					m_address_4.sin_port = htons(m_port);
+					length = sizeof(m_address_4);
+					result = (sockaddr *) &m_address_4;
+					break;
+				case AF_INET6:
+					memcpy(&m_address_6.sin6_addr, &((sockaddr_in6 *) address)->sin6_addr, 
+						sizeof(m_address_6.sin6_addr));
+					m_address_6.sin6_family = AF_INET6;
+					m_address_6.sin6_port = htons(m_port);
+					m_address_6.sin6_scope_id = ((sockaddr_in6 *) address)->sin6_scope_id;
+					length = sizeof(m_address_6);
+					result = (sockaddr *) &m_address_6;
+					break;
+				default:
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE_INET,
+						"%i", address->sa_family);
+			}
+
+			return result;
+		}
+
+		size_t 
+		_orbit_socket::batch(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_batch;
+		}
+
 		void 
 		_orbit_socket::close(void)
 		{
+			int error;
+
 			SERIALIZE_CALL_RECUR(m_lock);
 
-			if(!m_socket) {
+			if(!m_connect_event && !m_socket) {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
 			}
 
+			if(!close(error)) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::close), strerror(error));
+			}
+		}
+
+		bool 
+		_orbit_socket::close(
+			__out int &error
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			error = 0;
+
+			if(m_connect_event) {
+				connect_cancel();
+			} else if(!m_socket) {
+				error = EBADF;
+				return false;
+			}
+
 			if(m_socket) {
 
-				if(::close(m_socket) < 0) {
-					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-						"[%s] %s", CONCAT_STR(::close), strerror(errno));
+				if(!m_zerocopy_pending.empty()) {
+					zerocopy_wait();
+				}
+
+				rate_cancel();
+
+				if((m_watch ? m_watch->close(m_socket) : ::close(m_socket)) < 0) {
+					error = errno;
+					return false;
 				}
 
 				m_socket = 0;
+				m_watch = NULL;
 			}
 
-			if(m_information) {
-				freeaddrinfo(m_information);
-				m_information = NULL;
+			if(m_ring.is_initialized()) {
+				m_ring.uninitialize();
 			}
 
 			memset(&m_address_4, 0, sizeof(sockaddr_in));
 			memset(&m_address_6, 0, sizeof(sockaddr_in6));
+			m_blocking = true;
+			m_corked = false;
 			m_host.clear();
+			m_listening = false;
 			m_port = 0;
 			m_type = ORBIT_SOCKET_TYPE_NONE;
+			m_zerocopy = false;
+			m_zerocopy_next = 0;
+			m_zerocopy_pending.clear();
+
+			return true;
 		}
 
-		orbit_socket_family_t 
-		_orbit_socket::family(void)
+		void 
+		_orbit_socket::connect_attempt(void)
 		{
-			orbit_socket_family_t result = ORBIT_SOCKET_FAMILY_TYPE_NONE;
+			int descriptor;
+			sockaddr *address;
+			socklen_t length = 0;
+			sockaddr_storage candidate;
+			std::weak_ptr<orbit_socket_owner> guard;
 
 			SERIALIZE_CALL_RECUR(m_lock);
 
-			if(!m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
-			}
+			guard = m_connect_guard;
 
-			if(m_information) {
+			while(m_connect_next < m_connect_candidate.size()) {
+				candidate = m_connect_candidate[m_connect_next++];
 
-				switch(m_information->ai_family) {
-					case AF_INET:
-						result = ORBIT_SOCKET_FAMILY_TYPE_IPV4;
-						break;
-					case AF_INET6:
-						result = ORBIT_SOCKET_FAMILY_TYPE_IPV6;
-						break;
-					default:
-						THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE_INET,
-							"%i", m_information->ai_family);
+				descriptor = ::socket(candidate.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+				if(descriptor < 0) {
+					m_connect_error = errno;
+					continue;
 				}
-			}
 
-			return result;
-		}
+				address = address_set((sockaddr *) &candidate, length);
+				if(!::connect(descriptor, address, length)) {
+					connect_complete(descriptor, 0);
+					return;
+				} else if(errno != EINPROGRESS) {
+					m_connect_error = errno;
+					::close(descriptor);
+					continue;
+				}
 
-		bool 
-		_orbit_socket::is_open(void)
-		{
-			SERIALIZE_CALL_RECUR(m_lock);
-			return (m_socket != 0);
+				m_connect_event->add(descriptor, ORBIT_EVENT_WRITE, 
+					[guard](int descriptor, uint32_t events) {
+						_orbit_socket *socket;
+						std::shared_ptr<_orbit_socket> handle = connect_owner(guard, socket);
+
+						if(socket) {
+							socket->connect_event(descriptor, events);
+						}
+					});
+
+				m_connect_pending[descriptor] = std::pair<sockaddr_storage, orbit_timer_t>(candidate, 
+					m_connect_event->timer_add(m_connect_timeout, 
+						[guard, descriptor](orbit_timer_t timer) {
+							_orbit_socket *socket;
+							std::shared_ptr<_orbit_socket> handle = connect_owner(guard, socket);
+
+							if(socket) {
+								socket->connect_timeout(descriptor, timer);
+							}
+						}));
+
+				if(m_connect_next < m_connect_candidate.size()) {
+					m_connect_timer = m_connect_event->timer_add(SOCKET_CONNECT_DELAY, 
+						[guard](orbit_timer_t timer) {
+							_orbit_socket *socket;
+							std::shared_ptr<_orbit_socket> handle = connect_owner(guard, socket);
+
+							if(socket) {
+								socket->connect_delay(timer);
+							}
+						});
+				}
+
+				return;
+			}
+
+			if(m_connect_pending.empty()) {
+				connect_complete(0, m_connect_error ? m_connect_error : EHOSTUNREACH);
+			}
 		}
 
 		void 
-		_orbit_socket::open_tcp(void)
+		_orbit_socket::connect_bind(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 
-			if(m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_OPEN);
+			if(!m_connect_guard) {
+				return;
 			}
 
-			open_tcp(m_host, m_port);
+			std::lock_guard<std::mutex> lock(m_connect_guard->lock);
+
+			m_connect_guard->socket = this;
+
+			try {
+				m_connect_guard->handle = shared_from_this();
+				m_connect_guard->pinned = true;
+			} catch(std::bad_weak_ptr &) {
+				m_connect_guard->handle.reset();
+				m_connect_guard->pinned = false;
+			}
 		}
 
 		void 
-		_orbit_socket::open_tcp(
-			__in const std::string &host,
-			__in uint16_t port
-			)
+		_orbit_socket::connect_cancel(void)
 		{
-			int result;
+			std::map<int, std::pair<sockaddr_storage, orbit_timer_t>>::iterator iter;
 
 			SERIALIZE_CALL_RECUR(m_lock);
 
-			if(m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_OPEN);
-			}
-
-			memset(&m_address_4, 0, sizeof(sockaddr_in));
-			memset(&m_address_6, 0, sizeof(sockaddr_in6));
-			m_host = host;
-			m_port = port;
-			m_type = ORBIT_SOCKET_TYPE_TCP;
-
-			result = getaddrinfo(CHECK_STR(host), NULL, NULL, &m_information);
-			if(result) {
-				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-					"[%s] %s", CONCAT_STR(getaddrinfo), gai_strerror(result));
-			}
-
-			m_socket = ::socket(m_information->ai_family, SOCK_STREAM, 0);
-			if(!m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-					"[%s] %s", CONCAT_STR(::socket), strerror(errno));
-			}
+			if(m_connect_event && m_connect_event->is_initialized()) {
 
-			switch(m_information->ai_family) {
-				case AF_INET:
-					memcpy(&m_address_4.sin_addr, &((sockaddr_in *) m_information->ai_addr)->sin_addr, 
-						sizeof(m_address_4.sin_addr));
-					m_address_4.sin_family = m_information->ai_family;
-					m_address_4.sin_port = htons(m_port);
+				for(iter = m_connect_pending.begin(); iter != m_connect_pending.end(); ++iter) {
 
-					result = ::connect(m_socket, (sockaddr *) &m_address_4, sizeof(m_address_4));
-					if(result < 0) {
-						THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-							"[%s] %s", CONCAT_STR(::connect), strerror(errno));
+					if(m_connect_event->contains(iter->first)) {
+						m_connect_event->remove(iter->first);
 					}
-					break;
-				case AF_INET6:
-					memcpy(&m_address_6.sin6_addr, &((sockaddr_in6 *) m_information->ai_addr)->sin6_addr, 
-						sizeof(m_address_6.sin6_addr));
-					m_address_6.sin6_family = m_information->ai_family;
-					m_address_6.sin6_port = htons(m_port);
 
-					result = ::connect(m_socket, (sockaddr *) &m_address_6, sizeof(m_address_6));
-					if(result < 0) {
-						THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-							"[%s] %s", CONCAT_STR(::connect), strerror(errno));
+					if((iter->second.second != TIMER_INVALID)
+							&& m_connect_event->timer_contains(iter->second.second)) {
+						m_connect_event->timer_remove(iter->second.second);
 					}
-					break;
-				default:
-					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE_INET,
-						"%i", m_information->ai_family);
+
+					::close(iter->first);
+				}
+
+				if((m_connect_timer != TIMER_INVALID)
+						&& m_connect_event->timer_contains(m_connect_timer)) {
+					m_connect_event->timer_remove(m_connect_timer);
+				}
 			}
+
+			m_connect_candidate.clear();
+			m_connect_complete = nullptr;
+			m_connect_error = 0;
+			m_connect_event = NULL;
+			m_connect_guard.reset();
+			m_connect_next = 0;
+			m_connect_pending.clear();
+			m_connect_timer = TIMER_INVALID;
+			m_connect_timeout = 0;
 		}
 
-		uint16_t 
-		_orbit_socket::port(void)
+		bool 
+		_orbit_socket::connect_candidate(
+			__in const orbit_resolver_address_t &candidate,
+			__out int &error
+			)
 		{
+			sockaddr *address;
+			socklen_t length = 0;
+			orbit_resolver_address_t::const_iterator iter;
+
 			SERIALIZE_CALL_RECUR(m_lock);
 
+			error = EHOSTUNREACH;
+
+			for(iter = candidate.begin(); iter != candidate.end(); ++iter) {
+
+				m_socket = ::socket(iter->ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+				if(m_socket < 0) {
+					error = errno;
+					m_socket = 0;
+					continue;
+				}
+
+				address = address_set((sockaddr *) &(*iter), length);
+				if(!::connect(m_socket, address, length)) {
+					error = 0;
+					break;
+				}
+
+				error = errno;
+				::close(m_socket);
+				m_socket = 0;
+			}
+
 			if(!m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+				memset(&m_address_4, 0, sizeof(sockaddr_in));
+				memset(&m_address_6, 0, sizeof(sockaddr_in6));
+				m_type = ORBIT_SOCKET_TYPE_NONE;
+				return false;
 			}
 
-			return m_port;	
+			return true;
 		}
 
-		int 
-		_orbit_socket::read(
-			__in orbit_buf_t &output
+		void 
+		_orbit_socket::connect_complete(
+			__in int descriptor,
+			__in int error
 			)
 		{
-			int result = 0, len;
-			bool receiving = true;
-			orbit_buf_t buffer;
+			socklen_t length;
+			orbit_socket_connect_cb complete;
+			sockaddr_storage address;
+			std::map<int, std::pair<sockaddr_storage, orbit_timer_t>>::iterator iter;
 
 			SERIALIZE_CALL_RECUR(m_lock);
 
-			if(!m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
-			}
+			complete = m_connect_complete;
 
-			output.clear();
+			iter = m_connect_pending.find(descriptor);
+			if(iter != m_connect_pending.end()) {
+				address = iter->second.first;
 
-			while(receiving) {
-				buffer.resize(SOCKET_BLOCK_READ_LEN, 0);
+				if(m_connect_event->contains(descriptor)) {
+					m_connect_event->remove(descriptor);
+				}
 
-				len = ::recv(m_socket, (uint8_t *) &buffer[0], SOCKET_BLOCK_READ_LEN, 0);
-				if(len < 0) {
-					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-						"[%s] %s", CONCAT_STR(::recv), strerror(errno));
-				} else if(len) {					
-					output.insert(output.end(), buffer.begin(), buffer.begin() + len);
-					result += len;
-				} else {
-					receiving = false;
+				if((iter->second.second != TIMER_INVALID)
+						&& m_connect_event->timer_contains(iter->second.second)) {
+					m_connect_event->timer_remove(iter->second.second);
 				}
+
+				m_connect_pending.erase(iter);
+			} else if(descriptor) {
+				address = m_connect_candidate[m_connect_next - 1];
 			}
 
-			return result;
+			connect_cancel();
+
+			if(descriptor && !error) {
+				m_socket = descriptor;
+				m_blocking = false;
+				address_set((sockaddr *) &address, length);
+			} else {
+				memset(&m_address_4, 0, sizeof(sockaddr_in));
+				memset(&m_address_6, 0, sizeof(sockaddr_in6));
+				m_type = ORBIT_SOCKET_TYPE_NONE;
+			}
+
+			if(complete) {
+				complete(*this, error);
+			}
 		}
 
-		int 
-		_orbit_socket::read(
-			__in std::string &output
+		void 
+		_orbit_socket::connect_delay(
+			__in orbit_timer_t timer
 			)
 		{
-			int result;
-			orbit_buf_t buffer;
-
 			SERIALIZE_CALL_RECUR(m_lock);
 
-			if(!m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			if(m_connect_timer == timer) {
+				m_connect_timer = TIMER_INVALID;
+				connect_attempt();
 			}
-
-			result = read(buffer);
-			output = std::string(buffer.begin(), buffer.end());
-
-			return result;
 		}
 
-		std::string 
-		_orbit_socket::to_string(
-			__in_opt bool verbose
+		void 
+		_orbit_socket::connect_event(
+			__in int descriptor,
+			__in uint32_t events
 			)
 		{
-			void *addr = NULL;
-			std::string addr_str;
-			std::stringstream result;
+			int error = 0;
+			socklen_t length = sizeof(error);
 
 			SERIALIZE_CALL_RECUR(m_lock);
 
-			result << CHECK_STR(orbit_uid::to_string()) << " [" << ORBIT_SOCKET_TYPE_STRING(m_type) 
-				<< ", " << (m_socket ? "CONN" : "DISC");
-
-			if(m_socket) {
-				result << ", " << ORBIT_SOCKET_FAMILY_TYPE_STRING(family());
+			if(m_connect_pending.find(descriptor) == m_connect_pending.end()) {
+				return;
 			}
 
-			result << "]";
+			if(getsockopt(descriptor, SOL_SOCKET, SO_ERROR, &error, &length) < 0) {
+				error = errno;
+			}
 
-			if(verbose && m_socket) {
-				result << " " << CHECK_STR(m_host);
+			if(!error && (events & ORBIT_EVENT_WRITE)) {
+				connect_complete(descriptor, 0);
+			} else if(error || (events & (ORBIT_EVENT_ERROR | ORBIT_EVENT_HANGUP))) {
+				connect_fail(descriptor, error ? error : ECONNREFUSED);
+			}
+		}
 
-				if(m_information) {
+		void 
+		_orbit_socket::connect_fail(
+			__in int descriptor,
+			__in int error
+			)
+		{
+			std::map<int, std::pair<sockaddr_storage, orbit_timer_t>>::iterator iter;
 
-					switch(m_information->ai_family) {
-						case AF_INET:
-							addr = &((sockaddr_in *) m_information->ai_addr)->sin_addr;
-							break;
-						case AF_INET6:
-							addr = &((sockaddr_in6 *) m_information->ai_addr)->sin6_addr;
-							break;
-						default:
-							THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE_INET,
-								"%i", m_information->ai_family);
-					}
+			SERIALIZE_CALL_RECUR(m_lock);
 
-					addr_str.resize(SOCKET_ADDR_STR_MAX);
+			iter = m_connect_pending.find(descriptor);
+			if(iter != m_connect_pending.end()) {
 
-					if(!inet_ntop(m_information->ai_family, addr, (char *) &addr_str[0], 
-							SOCKET_ADDR_STR_MAX)) {
-						THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-							"[%s] %s", CONCAT_STR(inet_ntop), strerror(errno));
-					}
+				if(m_connect_event->contains(descriptor)) {
+					m_connect_event->remove(descriptor);
+				}
 
-					result << " " << CHECK_STR(addr_str);
+				if((iter->second.second != TIMER_INVALID)
+						&& m_connect_event->timer_contains(iter->second.second)) {
+					m_connect_event->timer_remove(iter->second.second);
 				}
 
-				result << ":" << m_port;
+				::close(descriptor);
+				m_connect_pending.erase(iter);
 			}
 
-			return CHECK_STR(result.str());
+			m_connect_error = error;
+
+			if((m_connect_timer != TIMER_INVALID)
+					&& m_connect_event->timer_contains(m_connect_timer)) {
+				m_connect_event->timer_remove(m_connect_timer);
+			}
+
+			m_connect_timer = TIMER_INVALID;
+			connect_attempt();
 		}
 
-		orbit_socket_t 
-		_orbit_socket::type(void)
+		std::shared_ptr<_orbit_socket> 
+		_orbit_socket::connect_owner(
+			__in const std::weak_ptr<orbit_socket_owner> &guard,
+			__out _orbit_socket *&socket
+			)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
+			std::shared_ptr<_orbit_socket> result;
+			std::shared_ptr<orbit_socket_owner> owner = guard.lock();
 
-			if(!m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			socket = NULL;
+
+			if(owner) {
+				std::lock_guard<std::mutex> lock(owner->lock);
+
+				if(owner->pinned) {
+					result = owner->handle.lock();
+					if(result) {
+						socket = owner->socket;
+					}
+				} else {
+					socket = owner->socket;
+				}
 			}
 
-			return m_type;
+			return result;
 		}
 
-		int 
-		_orbit_socket::write(
-			__in const orbit_buf_t &input
+		void 
+		_orbit_socket::connect_resolve(
+			__in int error,
+			__in const orbit_resolver_address_t &address
 			)
 		{
-			int result;
+			bool prefer_6;
+			orbit_resolver_address_t family_4, family_6;
+			orbit_resolver_address_t::const_iterator iter, iter_4, iter_6;
 
 			SERIALIZE_CALL_RECUR(m_lock);
 
-			if(!m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			if(!m_connect_event) {
+				return;
 			}
 
-			result = ::write(m_socket, (uint8_t *) &input[0], input.size());
-			if(result < 0) {
-				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
-					"[%s] %s", CONCAT_STR(::write), strerror(errno));
+			if(error) {
+				connect_complete(0, resolve_error(error));
+				return;
+			}
+
+			for(iter = address.begin(); iter != address.end(); ++iter) {
+
+				switch(iter->ss_family) {
+					case AF_INET:
+						family_4.push_back(*iter);
+						break;
+					case AF_INET6:
+						family_6.push_back(*iter);
+						break;
+					default:
+						break;
+				}
+			}
+
+			prefer_6 = (!address.empty() && (address.front().ss_family == AF_INET6));
+			iter_4 = family_4.begin();
+			iter_6 = family_6.begin();
+
+			while((iter_4 != family_4.end()) || (iter_6 != family_6.end())) {
+
+				if(prefer_6 && (iter_6 != family_6.end())) {
+					m_connect_candidate.push_back(*iter_6++);
+				} else if(!prefer_6 && (iter_4 != family_4.end())) {
+					m_connect_candidate.push_back(*iter_4++);
+				} else if(iter_6 != family_6.end()) {
+					m_connect_candidate.push_back(*iter_6++);
+				} else {
+					m_connect_candidate.push_back(*iter_4++);
+				}
+
+				prefer_6 = !prefer_6;
+			}
+
+			connect_attempt();
+		}
+
+		void 
+		_orbit_socket::connect_timeout(
+			__in int descriptor,
+			__in orbit_timer_t timer
+			)
+		{
+			std::map<int, std::pair<sockaddr_storage, orbit_timer_t>>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			iter = m_connect_pending.find(descriptor);
+			if((iter != m_connect_pending.end()) && (iter->second.second == timer)) {
+				iter->second.second = TIMER_INVALID;
+				connect_fail(descriptor, ETIMEDOUT);
+			}
+		}
+
+		void 
+		_orbit_socket::cork(void)
+		{
+			int value = 1;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			if(!m_corked) {
+
+				if(setsockopt(m_socket, IPPROTO_TCP, TCP_CORK, &value, sizeof(value)) < 0) {
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(setsockopt), strerror(errno));
+				}
+
+				m_corked = true;
+			}
+		}
+
+		void 
+		_orbit_socket::datagram_address(
+			__in const std::string &host,
+			__in uint16_t port,
+			__out orbit_socket_datagram &datagram
+			)
+		{
+			orbit_resolver_address_t address;
+
+			address = orbit::acquire()->acquire_resolver()->resolve(CHECK_STR(host));
+			datagram.address = address.front();
+			datagram.truncated = false;
+
+			switch(datagram.address.ss_family) {
+				case AF_INET:
+					((sockaddr_in *) &datagram.address)->sin_port = htons(port);
+					datagram.length = sizeof(sockaddr_in);
+					break;
+				case AF_INET6:
+					((sockaddr_in6 *) &datagram.address)->sin6_port = htons(port);
+					datagram.length = sizeof(sockaddr_in6);
+					break;
+				default:
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE_INET,
+						"%i", datagram.address.ss_family);
+			}
+		}
+
+		int 
+		_orbit_socket::descriptor(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			return m_socket;
+		}
+
+		orbit_socket_family_t 
+		_orbit_socket::family(void)
+		{
+			orbit_socket_family_t result = ORBIT_SOCKET_FAMILY_TYPE_NONE;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			if(m_address_4.sin_family == AF_INET) {
+				result = ORBIT_SOCKET_FAMILY_TYPE_IPV4;
+			} else if(m_address_6.sin6_family == AF_INET6) {
+				result = ORBIT_SOCKET_FAMILY_TYPE_IPV6;
+			}
+
+			return result;
+		}
+
+		void 
+		_orbit_socket::flush(void)
+		{
+			int value = 0;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			if(m_corked) {
+
+				if(setsockopt(m_socket, IPPROTO_TCP, TCP_CORK, &value, sizeof(value)) < 0) {
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(setsockopt), strerror(errno));
+				}
+
+				m_corked = false;
+			}
+		}
+
+		bool 
+		_orbit_socket::is_blocking(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_blocking;
+		}
+
+		bool 
+		_orbit_socket::is_connecting(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return (m_connect_event != NULL);
+		}
+
+		bool 
+		_orbit_socket::is_corked(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_corked;
+		}
+
+		bool 
+		_orbit_socket::is_listening(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_listening;
+		}
+
+		bool 
+		_orbit_socket::is_open(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return (m_socket != 0);
+		}
+
+		bool 
+		_orbit_socket::is_zerocopy(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_zerocopy;
+		}
+
+		void 
+		_orbit_socket::open_bind(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in orbit_socket_t type,
+			__in bool reuse,
+			__in bool blocking
+			)
+		{
+			int error = 0, value;
+			sockaddr *address = NULL;
+			socklen_t length = 0;
+			orbit_resolver_address_t candidate;
+			orbit_resolver_address_t::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_socket || m_connect_event) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_OPEN);
+			}
+
+			resolve(host, port, type, candidate);
+
+			for(iter = candidate.begin(); iter != candidate.end(); ++iter) {
+
+				m_socket = ::socket(iter->ss_family, ((type == ORBIT_SOCKET_TYPE_TCP) ? SOCK_STREAM : SOCK_DGRAM) 
+					| SOCK_CLOEXEC | (blocking ? 0 : SOCK_NONBLOCK), 0);
+				if(m_socket < 0) {
+					error = errno;
+					m_socket = 0;
+					continue;
+				}
+
+				value = 0;
+
+				if((iter->ss_family == AF_INET6)
+						&& (setsockopt(m_socket, IPPROTO_IPV6, IPV6_V6ONLY, &value, sizeof(value)) < 0)) {
+					error = errno;
+					::close(m_socket);
+					m_socket = 0;
+					continue;
+				}
+
+				value = 1;
+
+				if(reuse && ((setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value)) < 0)
+						|| (setsockopt(m_socket, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) < 0))) {
+					error = errno;
+					::close(m_socket);
+					m_socket = 0;
+					continue;
+				}
+
+				address = address_set((sockaddr *) &(*iter), length);
+				if(!::bind(m_socket, address, length)) {
+					break;
+				}
+
+				error = errno;
+				::close(m_socket);
+				m_socket = 0;
+			}
+
+			if(!m_socket) {
+				memset(&m_address_4, 0, sizeof(sockaddr_in));
+				memset(&m_address_6, 0, sizeof(sockaddr_in6));
+				m_type = ORBIT_SOCKET_TYPE_NONE;
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::bind), strerror(error));
+			}
+
+			if(getsockname(m_socket, address, &length) < 0) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(getsockname), strerror(errno));
+			}
+
+			m_blocking = blocking;
+			m_port = ntohs((m_address_4.sin_family == AF_INET) ? m_address_4.sin_port 
+				: m_address_6.sin6_port);
+		}
+
+		bool 
+		_orbit_socket::open_descriptor(
+			__in int descriptor,
+			__in const sockaddr *peer,
+			__out int &error
+			)
+		{
+			char host[SOCKET_ADDR_STR_MAX] = {};
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			error = 0;
+
+			if(m_socket || m_connect_event) {
+				error = EISCONN;
+				return false;
+			}
+
+			memset(&m_address_4, 0, sizeof(sockaddr_in));
+			memset(&m_address_6, 0, sizeof(sockaddr_in6));
+
+			switch(peer->sa_family) {
+				case AF_INET:
+					memcpy(&m_address_4, peer, sizeof(m_address_4));
+					m_port = ntohs(m_address_4.sin_port);
+					inet_ntop(AF_INET, &m_address_4.sin_addr, host, SOCKET_ADDR_STR_MAX);
+					break;
+				case AF_INET6:
+					memcpy(&m_address_6, peer, sizeof(m_address_6));
+					m_port = ntohs(m_address_6.sin6_port);
+					inet_ntop(AF_INET6, &m_address_6.sin6_addr, host, SOCKET_ADDR_STR_MAX);
+					break;
+				default:
+					m_port = 0;
+					error = EAFNOSUPPORT;
+					return false;
+			}
+
+			m_blocking = false;
+			m_host = host;
+			m_socket = descriptor;
+			m_type = ORBIT_SOCKET_TYPE_TCP;
+
+			return true;
+		}
+
+		void 
+		_orbit_socket::open_listen(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in_opt int backlog
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			open_bind(host, port, ORBIT_SOCKET_TYPE_TCP, true, false);
+
+			if(::listen(m_socket, backlog) < 0) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::listen), strerror(errno));
+			}
+
+			m_listening = true;
+		}
+
+		void 
+		_orbit_socket::open_tcp(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_OPEN);
+			}
+
+			open_tcp(m_host, m_port);
+		}
+
+		void 
+		_orbit_socket::open_tcp(
+			__in const std::string &host,
+			__in uint16_t port
+			)
+		{
+			int error;
+			orbit_resolver_address_t candidate;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_socket || m_connect_event) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_OPEN);
+			}
+
+			resolve(host, port, ORBIT_SOCKET_TYPE_TCP, candidate);
+
+			if(!connect_candidate(candidate, error)) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::connect), strerror(error));
+			}
+		}
+
+		bool 
+		_orbit_socket::open_tcp(
+			__in const std::string &host,
+			__in uint16_t port,
+			__out int &error
+			)
+		{
+			orbit_resolver_address_t candidate;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			error = 0;
+
+			if(m_socket || m_connect_event) {
+				error = EISCONN;
+				return false;
+			}
+
+			if(!resolve(host, port, ORBIT_SOCKET_TYPE_TCP, candidate, error)) {
+				error = resolve_error(error);
+				return false;
+			}
+
+			return connect_candidate(candidate, error);
+		}
+
+		void 
+		_orbit_socket::open_tcp(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in uint32_t timeout,
+			__in const orbit_socket_connect_cb &complete,
+			__in_opt orbit_event_ptr event
+			)
+		{
+			orbit_resolver_address_t address;
+			std::weak_ptr<orbit_socket_owner> guard;
+			orbit_resolver_ptr resolver = orbit::acquire()->acquire_resolver();
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_socket || m_connect_event) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_OPEN);
+			}
+
+			if(!event) {
+				event = orbit::acquire()->acquire_socket_factory()->acquire_event();
+			}
+
+			memset(&m_address_4, 0, sizeof(sockaddr_in));
+			memset(&m_address_6, 0, sizeof(sockaddr_in6));
+			m_host = host;
+			m_port = port;
+			m_type = ORBIT_SOCKET_TYPE_TCP;
+			m_connect_complete = complete;
+			m_connect_error = 0;
+			m_connect_event = event;
+			m_connect_next = 0;
+			m_connect_timer = TIMER_INVALID;
+			m_connect_guard = std::make_shared<orbit_socket_owner>();
+			connect_bind();
+			m_connect_timeout = timeout;
+
+			if(resolver->lookup(host, address)) {
+				connect_resolve(0, address);
+				return;
+			}
+
+			guard = m_connect_guard;
+			resolver->resolve(host, [event, guard](const std::string &host, int error, 
+					const orbit_resolver_address_t &address) {
+				UNREFERENCE_PARAM(host);
+
+				if(!guard.expired() && event->is_initialized()) {
+					event->post([guard, error, address](void) {
+							_orbit_socket *socket;
+							std::shared_ptr<_orbit_socket> handle = connect_owner(guard, socket);
+
+							if(socket) {
+								socket->connect_resolve(error, address);
+							}
+						});
+				}
+			});
+		}
+
+		void 
+		_orbit_socket::open_udp(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_OPEN);
+			}
+
+			open_udp(m_host, m_port);
+		}
+
+		void 
+		_orbit_socket::open_udp(
+			__in const std::string &host,
+			__in uint16_t port
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			open_bind(host, port, ORBIT_SOCKET_TYPE_UDP, false, true);
+			set_batch(m_batch);
+		}
+
+		uint16_t 
+		_orbit_socket::port(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			return m_port;	
+		}
+
+		orbit_rate_ptr 
+		_orbit_socket::rate_read(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_rate_read;
+		}
+
+		void 
+		_orbit_socket::rate_cancel(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_watch && (m_rate_timer != TIMER_INVALID) && m_watch->is_initialized() 
+					&& m_watch->timer_contains(m_rate_timer)) {
+				m_watch->timer_remove(m_rate_timer);
+			}
+
+			m_rate_events = 0;
+			m_rate_timer = TIMER_INVALID;
+		}
+
+		void 
+		_orbit_socket::rate_defer(
+			__in orbit_rate_ptr rate,
+			__in uint32_t events
+			)
+		{
+			int descriptor;
+			orbit_event_ptr event;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			descriptor = m_socket;
+			event = m_watch;
+
+			if(!event || !event->is_initialized()) {
+				return;
+			}
+
+			if((m_rate_timer != TIMER_INVALID) && event->timer_contains(m_rate_timer)) {
+
+				if((m_rate_events & events) == events) {
+					return;
+				}
+
+				event->timer_remove(m_rate_timer);
+			} else {
+				m_rate_events = 0;
+			}
+
+			m_rate_events |= events;
+			events = m_rate_events;
+			m_rate_timer = event->timer_add(std::max(rate->delay(), (uint32_t) 1), 
+				[event, descriptor, events](orbit_timer_t timer) {
+					UNREFERENCE_PARAM(timer);
+					event->dispatch(descriptor, events);
+				});
+		}
+
+		size_t 
+		_orbit_socket::rate_wait(
+			__in orbit_rate_ptr rate,
+			__in size_t length,
+			__in uint32_t events
+			)
+		{
+			size_t result = 0;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(length && !m_blocking) {
+
+				result = rate->acquire(length);
+				if(!result) {
+					rate_defer(rate, events);
+				}
+
+				return result;
+			}
+
+			while(length && !(result = rate->acquire(length))) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(std::max(rate->delay(), (uint32_t) 1)));
+			}
+
+			return result;
+		}
+
+		orbit_rate_ptr 
+		_orbit_socket::rate_write(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_rate_write;
+		}
+
+		int 
+		_orbit_socket::read(
+			__in orbit_buf_t &output
+			)
+		{
+			int error, result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			result = read(output, error);
+			if(error && (error != EAGAIN) && (error != ESHUTDOWN)) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::recv), strerror(error));
+			}
+
+			return std::max(result, 0);
+		}
+
+		int 
+		_orbit_socket::read(
+			__in orbit_buf_t &output,
+			__out int &error
+			)
+		{
+			int result = 0, len;
+			orbit_buffer block(BUFFER_BLOCK_LEN);
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			error = 0;
+			output.clear();
+
+			if(!m_socket) {
+				error = EBADF;
+				return SOCKET_ERROR;
+			}
+
+			for(;;) {
+
+				len = read_some(block.data(), block.capacity(), error);
+				if(len < 0) {
+					return (result ? result : len);
+				} else if(!len) {
+					error = ESHUTDOWN;
+					break;
+				}
+
+				output.insert(output.end(), block.data(), block.data() + len);
+				result += len;
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::read(
+			__in std::string &output
+			)
+		{
+			int result = 0, len;
+			orbit_buffer block(BUFFER_BLOCK_LEN);
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			output.clear();
+
+			for(;;) {
+
+				len = read_some(block.data(), block.capacity());
+				if((len == SOCKET_AGAIN) || !len) {
+					break;
+				}
+
+				output.insert(output.end(), block.data(), block.data() + len);
+				result += len;
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::read_batch(
+			__inout std::vector<orbit_socket_datagram> &output
+			)
+		{
+			int result;
+			size_t iter = 0;
+			mmsghdr *message;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			if(m_type != ORBIT_SOCKET_TYPE_UDP) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE,
+					"%s", ORBIT_SOCKET_TYPE_STRING(m_type));
+			}
+
+			output.resize(m_batch);
+
+			for(; iter < m_batch; ++iter) {
+				m_batch_buffer[iter].resize(SOCKET_DATAGRAM_LEN);
+				m_batch_vector[iter].iov_base = &m_batch_buffer[iter][0];
+				m_batch_vector[iter].iov_len = SOCKET_DATAGRAM_LEN;
+				message = &m_batch_message[iter];
+				message->msg_len = 0;
+				message->msg_hdr.msg_control = NULL;
+				message->msg_hdr.msg_controllen = 0;
+				message->msg_hdr.msg_flags = 0;
+				message->msg_hdr.msg_name = &output[iter].address;
+				message->msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+				message->msg_hdr.msg_iov = &m_batch_vector[iter];
+				message->msg_hdr.msg_iovlen = 1;
+			}
+
+			do {
+				result = ::recvmmsg(m_socket, &m_batch_message[0], m_batch, 
+					m_blocking ? MSG_WAITFORONE : 0, NULL);
+			} while((result < 0) && (errno == EINTR));
+
+			if(result < 0) {
+
+				if(!m_blocking 
+						&& ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+					output.clear();
+					return SOCKET_AGAIN;
+				}
+
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::recvmmsg), strerror(errno));
+			}
+
+			output.resize(result);
+
+			for(iter = 0; iter < (size_t) result; ++iter) {
+				output[iter].length = m_batch_message[iter].msg_hdr.msg_namelen;
+				output[iter].truncated = (m_batch_message[iter].msg_hdr.msg_flags & MSG_TRUNC);
+				output[iter].data.swap(m_batch_buffer[iter]);
+				output[iter].data.resize(m_batch_message[iter].msg_len);
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::read_exact(
+			__out uint8_t *output,
+			__in size_t length
+			)
+		{
+			int error, result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			result = read_exact(output, length, error);
+			if(error == EAGAIN) {
+				return result;
+			} else if(error == ESHUTDOWN) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_SHUTDOWN,
+					"%i/%zu", result, length);
+			} else if(error) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::recv), strerror(error));
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::read_exact(
+			__out uint8_t *output,
+			__in size_t length,
+			__out int &error
+			)
+		{
+			int len;
+			size_t result = 0, window;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			error = 0;
+
+			if(!m_socket) {
+				error = EBADF;
+				return result;
+			}
+
+			while(result < length) {
+
+				window = m_rate_read ? rate_wait(m_rate_read, length - result, ORBIT_EVENT_READ) 
+					: (length - result);
+				if(!window) {
+					error = EAGAIN;
+					return (result ? (int) result : SOCKET_AGAIN);
+				}
+
+				len = ::recv(m_socket, output + result, window, m_blocking ? MSG_WAITALL : 0);
+				error = errno;
+
+				if(m_rate_read && ((size_t) std::max(len, 0) < window)) {
+					m_rate_read->release(window - std::max(len, 0));
+				}
+
+				if(len < 0) {
+
+					if(error == EINTR) {
+						error = 0;
+						continue;
+					} else if(!m_blocking 
+							&& ((error == EAGAIN) || (error == EWOULDBLOCK))) {
+						error = EAGAIN;
+						return (result ? (int) result : SOCKET_AGAIN);
+					}
+
+					break;
+				} else if(!len) {
+					error = ESHUTDOWN;
+					break;
+				}
+
+				error = 0;
+				result += len;
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::read_exact(
+			__inout orbit_buf_t &output
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return (output.empty() ? 0 : read_exact(&output[0], output.size()));
+		}
+
+		int 
+		_orbit_socket::read_some(
+			__out uint8_t *output,
+			__in size_t length
+			)
+		{
+			int error, result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			result = read_some(output, length, error);
+			if(result == SOCKET_ERROR) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::recv), strerror(error));
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::read_some(
+			__out uint8_t *output,
+			__in size_t length,
+			__out int &error
+			)
+		{
+			int result;
+			size_t window = length;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			error = 0;
+
+			if(!m_socket) {
+				error = EBADF;
+				return SOCKET_ERROR;
+			}
+
+			if(m_rate_read && length) {
+
+				window = rate_wait(m_rate_read, length, ORBIT_EVENT_READ);
+				if(!window) {
+					error = EAGAIN;
+					return SOCKET_AGAIN;
+				}
+			}
+
+			do {
+				result = ::recv(m_socket, output, window, 0);
+			} while((result < 0) && (errno == EINTR));
+
+			error = errno;
+
+			if(m_rate_read && ((size_t) std::max(result, 0) < window)) {
+				m_rate_read->release(window - std::max(result, 0));
+			}
+
+			if(result < 0) {
+
+				if(!m_blocking 
+						&& ((error == EAGAIN) || (error == EWOULDBLOCK))) {
+					result = SOCKET_AGAIN;
+				} else {
+					result = SOCKET_ERROR;
+				}
+			}
+
+			if(result >= 0) {
+				error = 0;
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::read_some(
+			__inout orbit_buf_t &output
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return (output.empty() ? 0 : read_some(&output[0], output.size()));
+		}
+
+		int 
+		_orbit_socket::read_some(
+			__inout orbit_buffer &output
+			)
+		{
+			int result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!output.capacity()) {
+				output = orbit_buffer(BUFFER_BLOCK_LEN);
+			}
+
+			output.resize(output.capacity());
+
+			result = read_some(output.data(), output.capacity());
+			output.resize((result == SOCKET_AGAIN) ? 0 : result);
+
+			return result;
+		}
+
+		void 
+		_orbit_socket::resolve(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in orbit_socket_t type,
+			__out orbit_resolver_address_t &address
+			)
+		{
+			int error;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!resolve(host, port, type, address, error)) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s: %s", CONCAT_STR(getaddrinfo), CHECK_STR(host), gai_strerror(error));
+			}
+		}
+
+		bool 
+		_orbit_socket::resolve(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in orbit_socket_t type,
+			__out orbit_resolver_address_t &address,
+			__out int &error
+			)
+		{
+			sockaddr_storage entry;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			error = 0;
+			memset(&m_address_4, 0, sizeof(sockaddr_in));
+			memset(&m_address_6, 0, sizeof(sockaddr_in6));
+			address.clear();
+
+			if(host.empty()) {
+				memset(&entry, 0, sizeof(entry));
+				((sockaddr_in6 *) &entry)->sin6_family = AF_INET6;
+				((sockaddr_in6 *) &entry)->sin6_addr = in6addr_any;
+				address.push_back(entry);
+				memset(&entry, 0, sizeof(entry));
+				((sockaddr_in *) &entry)->sin_family = AF_INET;
+				((sockaddr_in *) &entry)->sin_addr.s_addr = htonl(INADDR_ANY);
+				address.push_back(entry);
+			} else {
+
+				address = orbit::acquire()->acquire_resolver()->resolve(host, error);
+				if(error) {
+					return false;
+				}
+			}
+
+			m_host = host;
+			m_port = port;
+			m_type = type;
+
+			return true;
+		}
+
+		int 
+		_orbit_socket::resolve_error(
+			__in int error
+			)
+		{
+			int result;
+
+			switch(error) {
+				case 0:
+					result = 0;
+					break;
+				case EAI_BADFLAGS:
+				case EAI_SYSTEM:
+					result = EINVAL;
+					break;
+				case EAI_CANCELED:
+					result = ECANCELED;
+					break;
+				case EAI_FAMILY:
+					result = EAFNOSUPPORT;
+					break;
+				case EAI_MEMORY:
+					result = ENOMEM;
+					break;
+				case EAI_SOCKTYPE:
+					result = ESOCKTNOSUPPORT;
+					break;
+				default:
+					result = EHOSTUNREACH;
+					break;
+			}
+
+			return result;
+		}
+
+		void 
+		_orbit_socket::ring_consume(
+			__in size_t length
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_ring.is_initialized()) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_RING);
+			}
+
+			m_ring.consume(length);
+		}
+
+		void 
+		_orbit_socket::ring_disable(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_ring.is_initialized()) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_RING);
+			}
+
+			m_ring.uninitialize();
+		}
+
+		void 
+		_orbit_socket::ring_enable(
+			__in_opt size_t capacity
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_ring.is_initialized()) {
+				m_ring.uninitialize();
+			}
+
+			m_ring.initialize(capacity);
+		}
+
+		int 
+		_orbit_socket::ring_fill(void)
+		{
+			size_t space;
+			int result = 0, len;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			if(!m_ring.is_initialized()) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_RING);
+			}
+
+			space = m_ring.space();
+			if(!space) {
+				return SOCKET_AGAIN;
+			}
+
+			for(; space; space = m_ring.space()) {
+
+				len = read_some(m_ring.reserve(), space);
+				if(len == SOCKET_AGAIN) {
+
+					if(!result) {
+						result = SOCKET_AGAIN;
+					}
+
+					break;
+				} else if(!len) {
+					break;
+				}
+
+				m_ring.commit(len);
+				result += len;
+
+				if(m_blocking) {
+					break;
+				}
+			}
+
+			return result;
+		}
+
+		bool 
+		_orbit_socket::ring_frame(
+			__out const uint8_t *&frame,
+			__out size_t &length
+			)
+		{
+			uint32_t prefix;
+			size_t available;
+			const uint8_t *data;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_ring.is_initialized()) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_RING);
+			}
+
+			available = m_ring.length();
+			if(available < SOCKET_FRAME_PREFIX_LEN) {
+				return false;
+			}
+
+			data = m_ring.peek();
+			memcpy(&prefix, data, SOCKET_FRAME_PREFIX_LEN);
+
+			length = SOCKET_FRAME_PREFIX_LEN + ntohl(prefix);
+			if(length > m_ring.capacity()) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_RING_FRAME,
+					"%zu/%zu", length, m_ring.capacity());
+			}
+
+			if(available < length) {
+				return false;
+			}
+
+			frame = data;
+
+			return true;
+		}
+
+		const uint8_t *
+		_orbit_socket::ring_peek(
+			__out size_t &length
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_ring.is_initialized()) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_RING);
+			}
+
+			length = m_ring.length();
+
+			return m_ring.peek();
+		}
+
+		void 
+		_orbit_socket::set_batch(
+			__in size_t batch
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!batch || (batch > SOCKET_BATCH_MAX)) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_BATCH,
+					"%zu (max. %u)", batch, SOCKET_BATCH_MAX);
+			}
+
+			m_batch = batch;
+			m_batch_buffer.resize(m_batch);
+			m_batch_message.resize(m_batch);
+			m_batch_vector.resize(m_batch);
+		}
+
+		void 
+		_orbit_socket::set_blocking(
+			__in bool blocking
+			)
+		{
+			int flags;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			if(blocking != m_blocking) {
+
+				flags = fcntl(m_socket, F_GETFL, 0);
+				if(flags < 0) {
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(fcntl), strerror(errno));
+				}
+
+				flags = blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+
+				if(fcntl(m_socket, F_SETFL, flags) < 0) {
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(fcntl), strerror(errno));
+				}
+
+				m_blocking = blocking;
+			}
+		}
+
+		void 
+		_orbit_socket::set_rate(
+			__in_opt orbit_rate_ptr read,
+			__in_opt orbit_rate_ptr write
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			m_rate_read = read;
+			m_rate_write = write;
+		}
+
+		void 
+		_orbit_socket::set_zerocopy(
+			__in bool zerocopy
+			)
+		{
+			int value = zerocopy ? 1 : 0;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			} else if(m_type != ORBIT_SOCKET_TYPE_TCP) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE,
+					"%s", ORBIT_SOCKET_TYPE_STRING(m_type));
+			}
+
+			if(zerocopy != m_zerocopy) {
+
+				if(setsockopt(m_socket, SOL_SOCKET, SO_ZEROCOPY, &value, sizeof(value)) < 0) {
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(setsockopt), strerror(errno));
+				}
+
+				m_zerocopy = zerocopy;
+			}
+		}
+
+		void 
+		_orbit_socket::swap(
+			__inout _orbit_socket &other
+			) noexcept
+		{
+			std::lock(m_lock, other.m_lock);
+			std::lock_guard<std::recursive_mutex> lock(m_lock, std::adopt_lock);
+			std::lock_guard<std::recursive_mutex> lock_other(other.m_lock, std::adopt_lock);
+
+			std::swap(m_address_4, other.m_address_4);
+			std::swap(m_address_6, other.m_address_6);
+			std::swap(m_batch, other.m_batch);
+			m_batch_buffer.swap(other.m_batch_buffer);
+			m_batch_message.swap(other.m_batch_message);
+			m_batch_vector.swap(other.m_batch_vector);
+			std::swap(m_blocking, other.m_blocking);
+			m_connect_candidate.swap(other.m_connect_candidate);
+			m_connect_complete.swap(other.m_connect_complete);
+			std::swap(m_connect_error, other.m_connect_error);
+			std::swap(m_connect_event, other.m_connect_event);
+			m_connect_guard.swap(other.m_connect_guard);
+			std::swap(m_connect_next, other.m_connect_next);
+			m_connect_pending.swap(other.m_connect_pending);
+			std::swap(m_connect_timer, other.m_connect_timer);
+			std::swap(m_connect_timeout, other.m_connect_timeout);
+			std::swap(m_corked, other.m_corked);
+			m_host.swap(other.m_host);
+			std::swap(m_listening, other.m_listening);
+			std::swap(m_port, other.m_port);
+			std::swap(m_rate_events, other.m_rate_events);
+			std::swap(m_rate_read, other.m_rate_read);
+			std::swap(m_rate_timer, other.m_rate_timer);
+			std::swap(m_rate_write, other.m_rate_write);
+			std::swap(m_ring, other.m_ring);
+			std::swap(m_socket, other.m_socket);
+			std::swap(m_type, other.m_type);
+			std::swap(m_watch, other.m_watch);
+			std::swap(m_zerocopy, other.m_zerocopy);
+			std::swap(m_zerocopy_next, other.m_zerocopy_next);
+			m_zerocopy_pending.swap(other.m_zerocopy_pending);
+
+			connect_bind();
+			other.connect_bind();
+		}
+
+		std::string 
+		_orbit_socket::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << CHECK_STR(orbit_uid::to_string()) << " [" << ORBIT_SOCKET_TYPE_STRING(m_type) 
+				<< ", " << (m_socket ? (m_listening ? "LISTEN" : "CONN") : "DISC");
+
+			if(m_socket) {
+				result << ", " << ORBIT_SOCKET_FAMILY_TYPE_STRING(family());
+			}
+
+			result << "]";
+
+			if(verbose && m_socket) {
+				result << " " << CHECK_STR(m_host) << " " << CHECK_STR(address()) 
+					<< ":" << m_port;
+			}
+
+			return CHECK_STR(result.str());
+		}
+
+		orbit_socket_t 
+		_orbit_socket::type(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			return m_type;
+		}
+
+		int 
+		_orbit_socket::write(
+			__in const orbit_buf_t &input
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return write(input.empty() ? NULL : &input[0], input.size());
+		}
+
+		int 
+		_orbit_socket::write(
+			__in const orbit_buffer &input
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_zerocopy && (input.length() >= SOCKET_ZEROCOPY_LEN)) {
+				return write_zerocopy(input);
+			}
+
+			return write(input.data(), input.length());
+		}
+
+		int 
+		_orbit_socket::write(
+			__in const std::string &input
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return write((const uint8_t *) input.c_str(), input.size());
+		}
+
+		int 
+		_orbit_socket::write(
+			__in const uint8_t *input,
+			__in size_t length
+			)
+		{
+			iovec vector;
+
+			vector.iov_base = (void *) input;
+			vector.iov_len = length;
+
+			return write(&vector, 1);
+		}
+
+		int 
+		_orbit_socket::write(
+			__in const uint8_t *input,
+			__in size_t length,
+			__out int &error
+			)
+		{
+			iovec vector;
+
+			vector.iov_base = (void *) input;
+			vector.iov_len = length;
+
+			return write(&vector, 1, error);
+		}
+
+		int 
+		_orbit_socket::write(
+			__in const iovec *input,
+			__in size_t count
+			)
+		{
+			int error, result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			result = write(input, count, error);
+			if(error && (error != EAGAIN)) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::sendmsg), strerror(error));
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::write(
+			__in const iovec *input,
+			__in size_t count,
+			__out int &error
+			)
+		{
+			msghdr message;
+			ssize_t len;
+			size_t granted = 0, index = 0, iter, offset = 0, result = 0, total, window;
+			iovec vector[SOCKET_WRITE_VECTOR_LEN];
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			error = 0;
+
+			if(!m_socket) {
+				error = EBADF;
+				return result;
+			}
+
+			while(index < count) {
+
+				if(offset == input[index].iov_len) {
+					offset = 0;
+					++index;
+					continue;
+				}
+
+				for(window = 0; (window < SOCKET_WRITE_VECTOR_LEN) && ((index + window) < count); ++window) {
+					vector[window] = input[index + window];
+				}
+
+				vector[0].iov_base = (uint8_t *) vector[0].iov_base + offset;
+				vector[0].iov_len -= offset;
+
+				if(m_rate_write) {
+
+					for(iter = 0, total = 0; iter < window; ++iter) {
+						total += vector[iter].iov_len;
+					}
+
+					granted = rate_wait(m_rate_write, total, ORBIT_EVENT_WRITE);
+					if(total && !granted) {
+						error = EAGAIN;
+						return (result ? (int) result : SOCKET_AGAIN);
+					}
+
+					for(iter = 0, total = 0; iter < window; ++iter) {
+
+						if((total + vector[iter].iov_len) >= granted) {
+							vector[iter].iov_len = granted - total;
+							window = iter + 1;
+							break;
+						}
+
+						total += vector[iter].iov_len;
+					}
+				}
+
+				memset(&message, 0, sizeof(message));
+				message.msg_iov = vector;
+				message.msg_iovlen = window;
+
+				len = ::sendmsg(m_socket, &message, MSG_NOSIGNAL 
+					| (((index + window) < count) ? MSG_MORE : 0));
+				error = errno;
+
+				if(m_rate_write && ((size_t) std::max(len, (ssize_t) 0) < granted)) {
+					m_rate_write->release(granted - std::max(len, (ssize_t) 0));
+				}
+
+				if(len < 0) {
+
+					if(error == EINTR) {
+						error = 0;
+						continue;
+					} else if(!m_blocking 
+							&& ((error == EAGAIN) || (error == EWOULDBLOCK))) {
+						error = EAGAIN;
+						return (result ? (int) result : SOCKET_AGAIN);
+					}
+
+					break;
+				}
+
+				error = 0;
+				result += len;
+
+				while(len && (index < count)) {
+
+					if((size_t) len < (input[index].iov_len - offset)) {
+						offset += len;
+						len = 0;
+					} else {
+						len -= (input[index].iov_len - offset);
+						offset = 0;
+						++index;
+					}
+				}
+			}
+
+			return result;
+		}
+
+		int 
+		_orbit_socket::write(
+			__in const std::vector<iovec> &input
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return write(input.empty() ? NULL : &input[0], input.size());
+		}
+
+		int 
+		_orbit_socket::write_batch(
+			__in const std::vector<orbit_socket_datagram> &input
+			)
+		{
+			int len;
+			mmsghdr *message;
+			size_t index = 0, iter, window;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			if(m_type != ORBIT_SOCKET_TYPE_UDP) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE,
+					"%s", ORBIT_SOCKET_TYPE_STRING(m_type));
+			}
+
+			while(index < input.size()) {
+				window = std::min(m_batch, input.size() - index);
+
+				for(iter = 0; iter < window; ++iter) {
+					const orbit_socket_datagram &datagram = input[index + iter];
+
+					m_batch_vector[iter].iov_base = (void *) (datagram.data.empty() ? NULL : &datagram.data[0]);
+					m_batch_vector[iter].iov_len = datagram.data.size();
+					message = &m_batch_message[iter];
+					memset(message, 0, sizeof(mmsghdr));
+					message->msg_hdr.msg_name = (void *) &datagram.address;
+					message->msg_hdr.msg_namelen = datagram.length;
+					message->msg_hdr.msg_iov = &m_batch_vector[iter];
+					message->msg_hdr.msg_iovlen = 1;
+				}
+
+				len = ::sendmmsg(m_socket, &m_batch_message[0], window, MSG_NOSIGNAL);
+				if(len < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					} else if(!m_blocking 
+							&& ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+						return (index ? (int) index : SOCKET_AGAIN);
+					}
+
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(::sendmmsg), strerror(errno));
+				}
+
+				index += len;
+			}
+
+			return index;
+		}
+
+		int 
+		_orbit_socket::write_file(
+			__in int descriptor,
+			__in off_t offset,
+			__in size_t length
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return write_file(descriptor, offset, length, orbit_buf_t());
+		}
+
+		int 
+		_orbit_socket::write_file(
+			__in int descriptor,
+			__in off_t offset,
+			__in size_t length,
+			__in const orbit_buf_t &header
+			)
+		{
+			ssize_t len, written;
+			int error;
+			bool fallback = false;
+			size_t index = 0, result = 0, window;
+			orbit_buffer block;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			while(index < header.size()) {
+
+				len = ::send(m_socket, &header[index], header.size() - index, MSG_NOSIGNAL 
+					| (length ? MSG_MORE : 0));
+				if(len < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					} else if(!m_blocking 
+							&& ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+						return (index ? (int) index : SOCKET_AGAIN);
+					}
+
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(::send), strerror(errno));
+				}
+
+				index += len;
+			}
+
+			result = index;
+
+			while(length && !fallback) {
+
+				window = std::min(length, (size_t) SOCKET_SENDFILE_LEN);
+
+				if(m_rate_write) {
+
+					window = rate_wait(m_rate_write, window, ORBIT_EVENT_WRITE);
+					if(!window) {
+						return (result ? (int) result : SOCKET_AGAIN);
+					}
+				}
+
+				len = ::sendfile(m_socket, descriptor, &offset, window);
+				error = errno;
+
+				if(m_rate_write && ((size_t) std::max(len, (ssize_t) 0) < window)) {
+					m_rate_write->release(window - std::max(len, (ssize_t) 0));
+				}
+
+				errno = error;
+
+				if(len < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					} else if(!m_blocking 
+							&& ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+						return (result ? (int) result : SOCKET_AGAIN);
+					} else if((errno == EINVAL) || (errno == ENOSYS) 
+							|| (errno == EOVERFLOW) || (errno == ESPIPE)) {
+						fallback = true;
+						continue;
+					}
+
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(::sendfile), strerror(errno));
+				} else if(!len) {
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_FILE,
+						"%zu remaining", length);
+				}
+
+				length -= len;
+				result += len;
+			}
+
+			if(length) {
+				block = orbit_buffer(BUFFER_BLOCK_LEN);
+			}
+
+			while(length) {
+
+				len = ::pread(descriptor, block.data(), std::min(length, block.capacity()), offset);
+				if(len < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					}
+
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(::pread), strerror(errno));
+				} else if(!len) {
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_FILE,
+						"%zu remaining", length);
+				}
+
+				written = write(block.data(), len);
+				if(written == SOCKET_AGAIN) {
+					break;
+				}
+
+				offset += written;
+				length -= written;
+				result += written;
+
+				if(written < len) {
+					break;
+				}
+			}
+
+			return ((result || !length) ? (int) result : SOCKET_AGAIN);
+		}
+
+		int 
+		_orbit_socket::write_zerocopy(
+			__in const orbit_buffer &input
+			)
+		{
+			ssize_t len;
+			int error, flags = MSG_NOSIGNAL | MSG_ZEROCOPY;
+			size_t result = 0, window;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			while(result < input.length()) {
+
+				window = m_rate_write ? rate_wait(m_rate_write, input.length() - result, ORBIT_EVENT_WRITE) 
+					: (input.length() - result);
+				if(!window) {
+					break;
+				}
+
+				len = ::send(m_socket, input.data() + result, window, flags);
+				error = errno;
+
+				if(m_rate_write && ((size_t) std::max(len, (ssize_t) 0) < window)) {
+					m_rate_write->release(window - std::max(len, (ssize_t) 0));
+				}
+
+				errno = error;
+
+				if(len < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					} else if(!m_blocking 
+							&& ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+						break;
+					} else if((errno == ENOBUFS) && (flags & MSG_ZEROCOPY)) {
+						zerocopy_complete();
+						flags &= ~MSG_ZEROCOPY;
+						continue;
+					}
+
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(::send), strerror(errno));
+				}
+
+				if(flags & MSG_ZEROCOPY) {
+					m_zerocopy_pending.insert(std::pair<uint32_t, orbit_buffer>(m_zerocopy_next++, input));
+				}
+
+				flags |= MSG_ZEROCOPY;
+				result += len;
+			}
+
+			if(m_zerocopy_pending.size() >= SOCKET_ZEROCOPY_BATCH) {
+				zerocopy_complete();
+			}
+
+			return ((result || !input.length()) ? (int) result : SOCKET_AGAIN);
+		}
+
+		size_t 
+		_orbit_socket::zerocopy_complete(void)
+		{
+			msghdr message;
+			cmsghdr *control;
+			sock_extended_err *error;
+			size_t result = 0, size;
+			uint8_t buffer[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_socket) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
+			}
+
+			while(!m_zerocopy_pending.empty()) {
+				memset(&message, 0, sizeof(message));
+				message.msg_control = buffer;
+				message.msg_controllen = sizeof(buffer);
+
+				if(::recvmsg(m_socket, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+
+					if(errno == EINTR) {
+						continue;
+					} else if((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+						break;
+					}
+
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(::recvmsg), strerror(errno));
+				}
+
+				for(control = CMSG_FIRSTHDR(&message); control; control = CMSG_NXTHDR(&message, control)) {
+
+					if(!((control->cmsg_level == SOL_IP) && (control->cmsg_type == IP_RECVERR))
+							&& !((control->cmsg_level == SOL_IPV6) && (control->cmsg_type == IPV6_RECVERR))) {
+						continue;
+					}
+
+					error = (sock_extended_err *) CMSG_DATA(control);
+					if(error->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+						continue;
+					}
+
+					size = m_zerocopy_pending.size();
+
+					if(error->ee_info <= error->ee_data) {
+						m_zerocopy_pending.erase(m_zerocopy_pending.lower_bound(error->ee_info), 
+							m_zerocopy_pending.upper_bound(error->ee_data));
+					} else {
+						m_zerocopy_pending.erase(m_zerocopy_pending.lower_bound(error->ee_info), 
+							m_zerocopy_pending.end());
+						m_zerocopy_pending.erase(m_zerocopy_pending.begin(), 
+							m_zerocopy_pending.upper_bound(error->ee_data));
+					}
+
+					result += (size - m_zerocopy_pending.size());
+				}
 			}
 
 			return result;
 		}
 
-		int 
-		_orbit_socket::write(
-			__in const std::string &input
-			)
+		void 
+		_orbit_socket::zerocopy_wait(void)
 		{
-			orbit_buf_t buffer;
+			int result;
+			pollfd event;
 
 			SERIALIZE_CALL_RECUR(m_lock);
 
-			if(!m_socket) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_CLOSE);
-			}
+			while(!m_zerocopy_pending.empty()) {
+				event.fd = m_socket;
+				event.events = 0;
+				event.revents = 0;
 
-			buffer = orbit_buf_t(input.begin(), input.end());
+				result = ::poll(&event, 1, SOCKET_ZEROCOPY_TIMEOUT);
+				if(result < 0) {
 
-			return write(buffer);
+					if(errno == EINTR) {
+						continue;
+					}
+
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+						"[%s] %s", CONCAT_STR(::poll), strerror(errno));
+				} else if(!result || !zerocopy_complete()) {
+					break;
+				}
+			}
 		}
 
 		orbit_socket_factory_ptr orbit_socket_factory::m_instance = NULL;
@@ -475,7 +2568,7 @@ namespace ORBIT {
 		_orbit_socket_factory::_orbit_socket_factory(void) :
 			m_initialized(false)
 		{
-			std::atexit(orbit_socket_factory::_delete);
+			return;
 		}
 
 		_orbit_socket_factory::~_orbit_socket_factory(void)
@@ -496,6 +2589,63 @@ namespace ORBIT {
 			}
 		}
 
+		orbit_uid 
+		_orbit_socket_factory::accept(
+			__in const orbit_uid &uid
+			)
+		{
+			orbit_uid result;
+			sockaddr_storage address;
+			orbit_socket_handle sock;
+			int descriptor, descriptor_listen, error;
+			socklen_t length = sizeof(address);
+			orbit_socket_handle listener = handle(uid);
+
+			if(!listener->is_listening()) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_TYPE,
+					"%s", CHECK_STR(orbit_uid::as_string(uid)));
+			}
+
+			descriptor_listen = listener->descriptor();
+
+			do {
+				length = sizeof(address);
+				descriptor = ::accept4(descriptor_listen, (sockaddr *) &address, &length, 
+					SOCK_NONBLOCK | SOCK_CLOEXEC);
+			} while((descriptor < 0) && (errno == EINTR));
+
+			if(descriptor < 0) {
+
+				if((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+					return result;
+				}
+
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::accept4), strerror(errno));
+			}
+
+			if(!m_initialized) {
+				::close(descriptor);
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
+			}
+
+			result = generate(std::string(), 0, ORBIT_SOCKET_TYPE_TCP);
+
+			sock = handle(result, error);
+			if(!sock || !sock->open_descriptor(descriptor, (sockaddr *) &address, error)) {
+				::close(descriptor);
+
+				if(sock) {
+					decrement_reference(result);
+				}
+
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(::accept4), strerror(error));
+			}
+
+			return result;
+		}
+
 		orbit_socket_factory_ptr 
 		_orbit_socket_factory::acquire(void)
 		{
@@ -506,15 +2656,15 @@ namespace ORBIT {
 				if(!orbit_socket_factory::m_instance) {
 					THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_ALLOCATION);
 				}
+
+				std::atexit(orbit_socket_factory::_delete);
 			}
 
 			return orbit_socket_factory::m_instance;
 		}
 
-		orbit_socket &
-		_orbit_socket_factory::at(
-			__in const orbit_uid &uid
-			)
+		orbit_event_ptr 
+		_orbit_socket_factory::acquire_event(void)
 		{
 			SERIALIZE_CALL_RECUR(m_lock);
 
@@ -522,21 +2672,175 @@ namespace ORBIT {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
 			}
 
-			return find(uid)->second.first;
+			return &m_event;
 		}
 
-		bool 
-		_orbit_socket_factory::contains(
+		orbit_rate_ptr 
+		_orbit_socket_factory::acquire_rate_read(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return &m_rate_read;
+		}
+
+		orbit_rate_ptr 
+		_orbit_socket_factory::acquire_rate_write(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return &m_rate_write;
+		}
+
+		orbit_socket_handle 
+		_orbit_socket_factory::at(
 			__in const orbit_uid &uid
 			)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
+			return handle(uid);
+		}
+
+		void 
+		_orbit_socket_factory::connect_launch(
+			__in const std::shared_ptr<orbit_socket_bulk> &state
+			)
+		{
+			size_t index;
+			orbit_uid uid;
+			std::weak_ptr<bool> guard;
+			std::vector<size_t> failed;
+			std::vector<size_t>::iterator iter;
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+				guard = m_guard;
+			}
+
+			{
+				std::lock_guard<std::recursive_mutex> lock(state->lock);
+
+				if(state->launching) {
+					return;
+				}
+
+				state->launching = true;
+
+				while((state->active < state->concurrency) && (state->next < state->endpoint.size())) {
+					index = state->next++;
+
+					orbit_socket_endpoint &entry = state->endpoint[index];
+
+					try {
+						uid = orbit_uid();
+						uid = generate(entry.first, entry.second, ORBIT_SOCKET_TYPE_TCP);
+						++state->active;
+						handle(uid)->open_tcp(entry.first, entry.second, state->timeout, 
+							[this, guard, state, index](const orbit_uid &uid, int error) {
+								orbit_uid result(uid);
+
+								if(!guard.expired() && state->event->is_initialized()) {
+									state->event->post([this, guard, state, index, result, error](void) {
+
+											if(!guard.expired()) {
+												connect_result(state, index, result, error);
+											}
+										});
+								}
+							}, state->event);
+					} catch(...) {
+
+						if(uid != orbit_uid()) {
+							--state->active;
+
+							if(contains(uid)) {
+								decrement_reference(uid);
+							}
+						}
+
+						failed.push_back(index);
+					}
+				}
+
+				state->launching = false;
+			}
+
+			if(state->complete) {
+
+				for(iter = failed.begin(); iter != failed.end(); ++iter) {
+					state->complete(*iter, orbit_uid(), EHOSTUNREACH);
+				}
+			}
+		}
+
+		void 
+		_orbit_socket_factory::connect_result(
+			__in const std::shared_ptr<orbit_socket_bulk> &state,
+			__in size_t index,
+			__in const orbit_uid &uid,
+			__in int error
+			)
+		{
+			orbit_uid result(uid);
+
+			{
+				std::lock_guard<std::recursive_mutex> lock(state->lock);
+				--state->active;
+			}
+
+			if(error) {
+
+				if(m_initialized && contains(result)) {
+					decrement_reference(result);
+				}
+
+				result = orbit_uid();
+			}
+
+			if(state->complete) {
+				state->complete(index, result, error);
+			}
+
+			if(m_initialized) {
+				connect_launch(state);
+			}
+		}
+
+		void 
+		_orbit_socket_factory::connect_tcp(
+			__in const std::vector<orbit_socket_endpoint> &endpoint,
+			__in size_t concurrency,
+			__in uint32_t timeout,
+			__in const orbit_socket_bulk_cb &complete,
+			__in_opt orbit_event_ptr event
+			)
+		{
+			std::shared_ptr<orbit_socket_bulk> state;
 
 			if(!m_initialized) {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
+			} else if(!concurrency) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_CONCURRENCY,
+					"%zu", concurrency);
 			}
 
-			return (m_map_socket.find(uid) != m_map_socket.end());
+			state = std::make_shared<orbit_socket_bulk>();
+			state->active = 0;
+			state->complete = complete;
+			state->concurrency = concurrency;
+			state->endpoint = endpoint;
+			state->event = event ? event : &m_event;
+			state->launching = false;
+			state->next = 0;
+			state->timeout = timeout;
+			connect_launch(state);
+		}
+
+		bool 
+		_orbit_socket_factory::contains(
+			__in const orbit_uid &uid
+			)
+		{
+			orbit_socket_shard &entry = shard(uid);
+			std::lock_guard<std::mutex> lock(entry.lock);
+
+			return (entry.map.find(uid) != entry.map.end());
 		}
 
 		size_t 
@@ -545,41 +2849,95 @@ namespace ORBIT {
 			)
 		{
 			size_t result;
-			std::map<orbit_uid, std::pair<orbit_socket, size_t>>::iterator iter;
+			orbit_socket_handle removed;
+			orbit_socket_shard &entry = shard(uid);
 
-			SERIALIZE_CALL_RECUR(m_lock);
+			{
+				std::lock_guard<std::mutex> lock(entry.lock);
 
-			if(!m_initialized) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
-			}
+				orbit_socket_shard_map::iterator iter = entry.map.find(uid);
+				if(iter == entry.map.end()) {
+					THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_NOT_FOUND,
+						"%s", CHECK_STR(orbit_uid::as_string(uid)));
+				}
 
-			iter = find(uid);
+				result = --iter->second.second;
+				if(result < REFERENCE_INIT) {
+					removed = iter->second.first;
+					entry.map.erase(iter);
+				}
+			}
 
-			result = --iter->second.second;
-			if(result < REFERENCE_INIT) {
-				m_map_socket.erase(iter);
+			if(removed && removed->is_open() 
+					&& (removed->m_watch == &m_event)) {
+				m_event.remove(removed->descriptor());
+				removed->rate_cancel();
+				removed->m_watch = NULL;
 			}
 
 			return result;
 		}
 
-		std::map<orbit_uid, std::pair<orbit_socket, size_t>>::iterator 
-		_orbit_socket_factory::find(
-			__in const orbit_uid &uid
+		orbit_uid 
+		_orbit_socket_factory::generate(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in orbit_socket_t type
 			)
 		{
-			std::map<orbit_uid, std::pair<orbit_socket, size_t>>::iterator result;
-
-			SERIALIZE_CALL_RECUR(m_lock);
+			orbit_uid result;
+			orbit_socket_handle sock;
 
 			if(!m_initialized) {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
 			}
 
-			result = m_map_socket.find(uid);
-			if(result == m_map_socket.end()) {
-				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_NOT_FOUND,
-					"%s", CHECK_STR(orbit_uid::as_string(uid)));
+			sock = std::make_shared<orbit_socket>(host, port);
+			sock->set_rate(&m_rate_read, &m_rate_write);
+			sock->m_type = type;
+			result = sock->uid();
+
+			orbit_socket_shard &entry = shard(result);
+			std::lock_guard<std::mutex> lock(entry.lock);
+
+			entry.map.insert(orbit_socket_shard_map::value_type(result, 
+				std::pair<orbit_socket_handle, size_t>(sock, REFERENCE_INIT)));
+
+			return result;
+		}
+
+		std::vector<orbit_uid> 
+		_orbit_socket_factory::generate_listen(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in_opt size_t count,
+			__in_opt int backlog
+			)
+		{
+			orbit_socket_handle listener;
+			std::vector<orbit_uid> result;
+			std::vector<orbit_uid>::iterator iter;
+
+			try {
+
+				for(; count; --count) {
+					result.push_back(generate(host, port, ORBIT_SOCKET_TYPE_TCP));
+
+					listener = handle(result.back());
+					listener->open_listen(host, port, backlog);
+					port = listener->port();
+				}
+			} catch(...) {
+				listener.reset();
+
+				for(iter = result.begin(); iter != result.end(); ++iter) {
+
+					if(contains(*iter)) {
+						decrement_reference(*iter);
+					}
+				}
+
+				throw;
 			}
 
 			return result;
@@ -591,47 +2949,100 @@ namespace ORBIT {
 			__in_opt uint16_t port
 			)
 		{
-			orbit_uid result;
+			return generate(host, port, ORBIT_SOCKET_TYPE_TCP);
+		}
 
-			SERIALIZE_CALL_RECUR(m_lock);
+		orbit_uid 
+		_orbit_socket_factory::generate_udp(
+			__in_opt const std::string &host,
+			__in_opt uint16_t port
+			)
+		{
+			return generate(host, port, ORBIT_SOCKET_TYPE_UDP);
+		}
 
-			if(!m_initialized) {
+		orbit_socket_handle 
+		_orbit_socket_factory::handle(
+			__in const orbit_uid &uid
+			)
+		{
+			int error;
+			orbit_socket_handle result;
+
+			result = handle(uid, error);
+			if(error == EINVAL) {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
+			} else if(error) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_NOT_FOUND,
+					"%s", CHECK_STR(orbit_uid::as_string(uid)));
 			}
 
-			orbit_socket sock(host, port);
-			result = sock.uid();
-			m_map_socket.insert(std::pair<orbit_uid, std::pair<orbit_socket, size_t>>(
-				result, std::pair<orbit_socket, size_t>(sock, REFERENCE_INIT)));
-
 			return result;
 		}
 
+		orbit_socket_handle 
+		_orbit_socket_factory::handle(
+			__in const orbit_uid &uid,
+			__out int &error
+			)
+		{
+			orbit_socket_shard_map::iterator iter;
+
+			error = 0;
+
+			if(!m_initialized) {
+				error = EINVAL;
+				return orbit_socket_handle();
+			}
+
+			orbit_socket_shard &entry = m_shard[uid.index() & (SOCKET_SHARD_COUNT - 1)];
+			std::lock_guard<std::mutex> lock(entry.lock);
+
+			iter = entry.map.find(uid);
+			if(iter == entry.map.end()) {
+				error = ENOENT;
+				return orbit_socket_handle();
+			}
+
+			return iter->second.first;
+		}
+
 		size_t 
 		_orbit_socket_factory::increment_reference(
 			__in const orbit_uid &uid
 			)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
+			orbit_socket_shard &entry = shard(uid);
+			std::lock_guard<std::mutex> lock(entry.lock);
 
-			if(!m_initialized) {
-				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
+			orbit_socket_shard_map::iterator iter = entry.map.find(uid);
+			if(iter == entry.map.end()) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_NOT_FOUND,
+					"%s", CHECK_STR(orbit_uid::as_string(uid)));
 			}
 
-			return ++find(uid)->second.second;
+			return ++iter->second.second;
 		}
 
 		void 
 		_orbit_socket_factory::initialize(void)
 		{
+			size_t iter;
+
 			SERIALIZE_CALL_RECUR(m_lock);
 
 			if(m_initialized) {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_INITIALIZE);
 			}
 
+			for(iter = 0; iter < SOCKET_SHARD_COUNT; ++iter) {
+				std::lock_guard<std::mutex> lock(m_shard[iter].lock);
+				m_shard[iter].map.clear();
+			}
+
+			m_event.initialize();
+			m_guard = std::make_shared<bool>(true);
 			m_initialized = true;
-			m_map_socket.clear();
 		}
 
 		bool 
@@ -643,34 +3054,96 @@ namespace ORBIT {
 		bool 
 		_orbit_socket_factory::is_initialized(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 			return m_initialized;
 		}
 
+		size_t 
+		_orbit_socket_factory::poll(
+			__in_opt int timeout
+			)
+		{
+
+			if(!m_initialized) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
+			}
+
+			return m_event.poll(timeout);
+		}
+
 		size_t 
 		_orbit_socket_factory::reference_count(
 			__in const orbit_uid &uid
 			)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
+			int error;
+			size_t result;
+
+			result = reference_count(uid, error);
+			if(error == EINVAL) {
+				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
+			} else if(error) {
+				THROW_ORBIT_SOCKET_EXCEPTION_MESSAGE(ORBIT_SOCKET_EXCEPTION_NOT_FOUND,
+					"%s", CHECK_STR(orbit_uid::as_string(uid)));
+			}
+
+			return result;
+		}
+
+		size_t 
+		_orbit_socket_factory::reference_count(
+			__in const orbit_uid &uid,
+			__out int &error
+			)
+		{
+			orbit_socket_shard_map::iterator iter;
+
+			error = 0;
+
+			if(!m_initialized) {
+				error = EINVAL;
+				return 0;
+			}
+
+			orbit_socket_shard &entry = m_shard[uid.index() & (SOCKET_SHARD_COUNT - 1)];
+			std::lock_guard<std::mutex> lock(entry.lock);
+
+			iter = entry.map.find(uid);
+			if(iter == entry.map.end()) {
+				error = ENOENT;
+				return 0;
+			}
+
+			return iter->second.second;
+		}
+
+		orbit_socket_shard &
+		_orbit_socket_factory::shard(
+			__in const orbit_uid &uid
+			)
+		{
 
 			if(!m_initialized) {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
 			}
 
-			return find(uid)->second.second;
+			return m_shard[uid.index() & (SOCKET_SHARD_COUNT - 1)];
 		}
 
 		size_t 
 		_orbit_socket_factory::size(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
+			size_t iter, result = 0;
 
 			if(!m_initialized) {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
 			}
 
-			return m_map_socket.size();
+			for(iter = 0; iter < SOCKET_SHARD_COUNT; ++iter) {
+				std::lock_guard<std::mutex> lock(m_shard[iter].lock);
+				result += m_shard[iter].map.size();
+			}
+
+			return result;
 		}
 
 		std::string 
@@ -678,9 +3151,11 @@ namespace ORBIT {
 			__in_opt bool verbose
 			)
 		{
-			size_t index = 1;
+			size_t index = 1, iter;
 			std::stringstream result;
-			std::map<orbit_uid, std::pair<orbit_socket, size_t>>::iterator iter;
+			orbit_socket_shard_map::iterator iter_shard;
+			std::map<orbit_uid, std::pair<orbit_socket_handle, size_t>> entry;
+			std::map<orbit_uid, std::pair<orbit_socket_handle, size_t>>::iterator iter_entry;
 
 			SERIALIZE_CALL_RECUR(m_lock);
 
@@ -691,10 +3166,19 @@ namespace ORBIT {
 				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
 			}
 
-			for(iter = m_map_socket.begin(); iter != m_map_socket.end(); ++index, ++iter) {
-				result << std::endl << "--- [" << index << "/" << m_map_socket.size() << "] "
-					<< iter->second.first.to_string(verbose) << ", ref: "
-					<< iter->second.second;
+			for(iter = 0; iter < SOCKET_SHARD_COUNT; ++iter) {
+				std::lock_guard<std::mutex> lock(m_shard[iter].lock);
+
+				for(iter_shard = m_shard[iter].map.begin(); iter_shard != m_shard[iter].map.end(); 
+						++iter_shard) {
+					entry.insert(*iter_shard);
+				}
+			}
+
+			for(iter_entry = entry.begin(); iter_entry != entry.end(); ++index, ++iter_entry) {
+				result << std::endl << "--- [" << index << "/" << entry.size() << "] "
+					<< iter_entry->second.first->to_string(verbose) << ", ref: "
+					<< iter_entry->second.second;
 			}
 
 			return CHECK_STR(result.str());
@@ -703,14 +3187,59 @@ namespace ORBIT {
 		void 
 		_orbit_socket_factory::uninitialize(void)
 		{
+			size_t iter;
+			orbit_socket_shard_map entry;
+
 			SERIALIZE_CALL_RECUR(m_lock);
 
 			if(!m_initialized) {
 				THROW_ORBIT_SOCKET_EXCEPTION(ORBIT_SOCKET_EXCEPTION_UNINITIALIZE);
 			}
 
-			m_map_socket.clear();
-			m_initialized =false;
+			m_initialized = false;
+			m_guard.reset();
+
+			for(iter = 0; iter < SOCKET_SHARD_COUNT; ++iter) {
+
+				{
+					std::lock_guard<std::mutex> lock(m_shard[iter].lock);
+					entry.swap(m_shard[iter].map);
+				}
+
+				entry.clear();
+			}
+
+			m_event.uninitialize();
+		}
+
+		void 
+		_orbit_socket_factory::unwatch(
+			__in const orbit_uid &uid
+			)
+		{
+			orbit_socket_handle sock = handle(uid);
+
+			m_event.remove(sock->descriptor());
+			sock->rate_cancel();
+			sock->m_watch = NULL;
+		}
+
+		void 
+		_orbit_socket_factory::watch(
+			__in const orbit_uid &uid,
+			__in uint32_t events,
+			__in const orbit_socket_event_cb &callback
+			)
+		{
+			orbit_socket_handle sock = handle(uid);
+
+			sock->set_blocking(false);
+			m_event.add(sock->descriptor(), events, 
+				[uid, callback](int descriptor, uint32_t events) {
+					UNREFERENCE_PARAM(descriptor);
+					callback(uid, events);
+				});
+			sock->m_watch = &m_event;
 		}
 	}
 }
@@ -0,0 +1,329 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../include/orbit.h"
+#include "../include/orbit_task_type.h"
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		static thread_local orbit_task_ptr task_owner = NULL;
+		static thread_local size_t task_index = 0;
+
+		orbit_task_ptr orbit_task::m_instance = NULL;
+
+		_orbit_task::_orbit_task(void) :
+			m_failed(0),
+			m_idle(0),
+			m_initialized(false),
+			m_next(0),
+			m_pending(0),
+			m_running(false),
+			m_submit(0)
+		{
+			std::atexit(orbit_task::_delete);
+		}
+
+		_orbit_task::~_orbit_task(void)
+		{
+
+			if(m_initialized) {
+				uninitialize();
+			}
+		}
+
+		void 
+		_orbit_task::_delete(void)
+		{
+
+			if(orbit_task::m_instance) {
+				delete orbit_task::m_instance;
+				orbit_task::m_instance = NULL;
+			}
+		}
+
+		orbit_task_ptr 
+		_orbit_task::acquire(void)
+		{
+
+			if(!orbit_task::m_instance) {
+
+				orbit_task::m_instance = new orbit_task;
+				if(!orbit_task::m_instance) {
+					THROW_ORBIT_TASK_EXCEPTION(ORBIT_TASK_EXCEPTION_ALLOCATION);
+				}
+			}
+
+			return orbit_task::m_instance;
+		}
+
+		void 
+		_orbit_task::enqueue(
+			__in const orbit_task_cb &callback
+			)
+		{
+			orbit_task_worker_ptr worker;
+
+			++m_submit;
+
+			if(!m_initialized || !m_running) {
+				--m_submit;
+				THROW_ORBIT_TASK_EXCEPTION(ORBIT_TASK_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(task_owner == this) {
+				worker = m_worker[task_index];
+			} else {
+				worker = m_worker[m_next.fetch_add(1, std::memory_order_relaxed) % m_worker.size()];
+			}
+
+			try {
+				std::lock_guard<std::mutex> lock(worker->lock);
+				worker->entry.push_back(callback);
+				++m_pending;
+			} catch(...) {
+				--m_submit;
+				throw;
+			}
+
+			--m_submit;
+
+			if(m_idle) {
+
+				{
+					std::lock_guard<std::mutex> lock(m_wait_lock);
+				}
+
+				m_wait.notify_one();
+			}
+		}
+
+		size_t 
+		_orbit_task::failed(void)
+		{
+			return m_failed;
+		}
+
+		void 
+		_orbit_task::initialize(
+			__in_opt size_t workers
+			)
+		{
+			size_t iter;
+			orbit_task_worker_ptr worker;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_initialized) {
+				THROW_ORBIT_TASK_EXCEPTION(ORBIT_TASK_EXCEPTION_INITIALIZE);
+			}
+
+			if(!workers) {
+				workers = std::max(std::thread::hardware_concurrency(), 1u);
+			}
+
+			for(iter = 0; iter < workers; ++iter) {
+
+				worker = new orbit_task_worker;
+				if(!worker) {
+					THROW_ORBIT_TASK_EXCEPTION(ORBIT_TASK_EXCEPTION_ALLOCATION);
+				}
+
+				m_worker.push_back(worker);
+			}
+
+			m_failed = 0;
+			m_idle = 0;
+			m_next = 0;
+			m_pending = 0;
+			m_submit = 0;
+			m_running = true;
+			m_initialized = true;
+
+			for(iter = 0; iter < workers; ++iter) {
+				m_worker[iter]->thread = std::thread(&_orbit_task::run, this, iter);
+			}
+		}
+
+		bool 
+		_orbit_task::is_allocated(void)
+		{
+			return (orbit_task::m_instance != NULL);
+		}
+
+		bool 
+		_orbit_task::is_initialized(void)
+		{
+			return m_initialized;
+		}
+
+		size_t 
+		_orbit_task::pending(void)
+		{
+			return m_pending;
+		}
+
+		void 
+		_orbit_task::run(
+			__in size_t index
+			)
+		{
+			orbit_task_cb callback;
+
+			task_owner = this;
+			task_index = index;
+
+			for(;;) {
+
+				if(take(index, callback)) {
+
+					try {
+						callback();
+					} catch(...) {
+						++m_failed;
+					}
+
+					callback = nullptr;
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(m_wait_lock);
+
+				++m_idle;
+				m_wait.wait(lock, [this](void) {
+						return ((!m_running && !m_submit) || m_pending);
+					});
+				--m_idle;
+
+				if(!m_running && !m_pending && !m_submit) {
+					break;
+				}
+			}
+
+			task_owner = NULL;
+		}
+
+		size_t 
+		_orbit_task::size(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_worker.size();
+		}
+
+		bool 
+		_orbit_task::take(
+			__in size_t index,
+			__out orbit_task_cb &callback
+			)
+		{
+			size_t iter = 0, victim;
+			bool result = false;
+
+			for(; !result && (iter < m_worker.size()); ++iter) {
+				victim = (index + iter) % m_worker.size();
+
+				std::lock_guard<std::mutex> lock(m_worker[victim]->lock);
+
+				std::deque<orbit_task_cb> &entry = m_worker[victim]->entry;
+				if(entry.empty()) {
+					continue;
+				}
+
+				if(!iter) {
+					callback = std::move(entry.back());
+					entry.pop_back();
+				} else {
+					callback = std::move(entry.front());
+					entry.pop_front();
+				}
+
+				result = true;
+			}
+
+			if(result) {
+				--m_pending;
+			}
+
+			return result;
+		}
+
+		std::string 
+		_orbit_task::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << "[" << (m_initialized ? "INIT" : "UNINIT") << "] " 
+				<< ORBIT_TASK_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			result << " [worker: " << m_worker.size() << ", pending: " << m_pending 
+				<< ", failed: " << m_failed << "]";
+
+			return CHECK_STR(result.str());
+		}
+
+		void 
+		_orbit_task::uninitialize(void)
+		{
+			std::vector<orbit_task_worker_ptr>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_TASK_EXCEPTION(ORBIT_TASK_EXCEPTION_UNINITIALIZE);
+			}
+
+			m_running = false;
+
+			while(m_submit) {
+				std::this_thread::yield();
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_wait_lock);
+			}
+
+			m_wait.notify_all();
+
+			for(iter = m_worker.begin(); iter != m_worker.end(); ++iter) {
+
+				if((*iter)->thread.joinable()) {
+					(*iter)->thread.join();
+				}
+			}
+
+			m_initialized = false;
+
+			for(iter = m_worker.begin(); iter != m_worker.end(); ++iter) {
+				delete *iter;
+			}
+
+			m_worker.clear();
+			m_pending = 0;
+		}
+	}
+}
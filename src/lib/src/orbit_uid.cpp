@@ -32,48 +32,19 @@ namespace ORBIT {
 			return;
 		}
 
-		_orbit_uid::_orbit_uid(
-			__in const _orbit_uid &other
-			) :
-				m_uid(other.m_uid)
-		{
-			return;
-		}
-
-		_orbit_uid::~_orbit_uid(void)
-		{
-			return;
-		}
-
-		_orbit_uid &
-		_orbit_uid::operator=(
-			__in const _orbit_uid &other
-			)
-		{
-			SERIALIZE_CALL_RECUR(m_lock);
-
-			if(this != &other) {
-				m_uid = other.m_uid;
-			}
-
-			return *this;
-		}
-
 		bool 
 		_orbit_uid::operator==(
 			__in const _orbit_uid &other
-			)
+			) const
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 			return (m_uid == other.m_uid);
 		}
 
 		bool 
 		_orbit_uid::operator!=(
 			__in const _orbit_uid &other
-			)
+			) const
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 			return !(*this == other);
 		}
 
@@ -92,19 +63,29 @@ namespace ORBIT {
 			return CHECK_STR(result.str());
 		}
 
+		uint8_t 
+		_orbit_uid::generation(void) const
+		{
+			return UID_GENERATION(m_uid);
+		}
+
+		uint32_t 
+		_orbit_uid::index(void) const
+		{
+			return UID_INDEX(m_uid);
+		}
+
 		std::string 
 		_orbit_uid::to_string(
 			__in_opt bool verbose
-			)
+			) const
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 			return CHECK_STR(as_string(*this, verbose));
 		}
 
-		orbit_uid_t &
-		_orbit_uid::uid(void)
+		orbit_uid_t 
+		_orbit_uid::uid(void) const
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 			return m_uid;
 		}
 
@@ -118,7 +99,7 @@ namespace ORBIT {
 		}
 
 		_orbit_uid_class::_orbit_uid_class(void) :
-			orbit_uid(orbit::acquire()->acquire_uid_factory()->generate())
+			orbit_uid(orbit_uid_factory::acquire()->generate())
 		{
 			return;
 		}
@@ -128,21 +109,29 @@ namespace ORBIT {
 			) :
 				orbit_uid(other)
 		{
-			orbit_uid_factory_ptr fact = orbit::acquire()->acquire_uid_factory();
+			orbit_uid_factory_ptr fact;
+
+			if(m_uid != UID_INVALID) {
 
-			if(fact->contains(*this)) {
-				fact->increment_reference(*this);
+				fact = orbit_uid_factory::acquire();
+				if(fact->is_initialized() 
+						&& fact->contains(*this)) {
+					fact->increment_reference(*this);
+				}
 			}
 		}
 
-		_orbit_uid_class::~_orbit_uid_class(void)
+		_orbit_uid_class::_orbit_uid_class(
+			__in _orbit_uid_class &&other
+			) noexcept :
+				orbit_uid(other)
 		{
-			orbit_uid_factory_ptr fact = orbit::acquire()->acquire_uid_factory();
+			other.m_uid = UID_INVALID;
+		}
 
-			if(fact->is_initialized() 
-					&& fact->contains(*this)) {
-				fact->decrement_reference(*this);
-			}
+		_orbit_uid_class::~_orbit_uid_class(void)
+		{
+			clear();
 		}
 
 		_orbit_uid_class &
@@ -150,68 +139,134 @@ namespace ORBIT {
 			__in const _orbit_uid_class &other
 			)
 		{
-			orbit_uid_factory_ptr fact = orbit::acquire()->acquire_uid_factory();
 
-			SERIALIZE_CALL_RECUR(m_lock);
+			if(this != &other) {
+				_orbit_uid_class copy(other);
+
+				std::swap(m_uid, copy.m_uid);
+			}
+
+			return *this;
+		}
+
+		_orbit_uid_class &
+		_orbit_uid_class::operator=(
+			__in _orbit_uid_class &&other
+			) noexcept
+		{
 
 			if(this != &other) {
+				clear();
 
-				if(fact->contains(*this)) {
-					fact->decrement_reference(*this);
-				}
+				m_uid = other.m_uid;
+				other.m_uid = UID_INVALID;
+			}
+
+			return *this;
+		}
+
+		void 
+		_orbit_uid_class::clear(void)
+		{
+			orbit_uid_factory_ptr fact;
 
-				orbit_uid::operator=(other);
+			if((m_uid != UID_INVALID) && orbit_uid_factory::is_allocated()) {
 
-				if(fact->contains(*this)) {
-					fact->increment_reference(*this);
+				fact = orbit_uid_factory::acquire();
+				if(fact->is_initialized() 
+						&& fact->contains(*this)) {
+					fact->decrement_reference(*this);
 				}
 			}
 
-			return *this;
+			m_uid = UID_INVALID;
 		}
 
 		bool 
 		_orbit_uid_class::contains(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
-			return orbit::acquire()->acquire_uid_factory()->contains(*this);
+			return orbit_uid_factory::acquire()->contains(*this);
 		}
 
 		size_t 
 		_orbit_uid_class::decrement_reference(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
-			return orbit::acquire()->acquire_uid_factory()->decrement_reference(*this);
+			return orbit_uid_factory::acquire()->decrement_reference(*this);
 		}
 
 		size_t 
 		_orbit_uid_class::increment_reference(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
-			return orbit::acquire()->acquire_uid_factory()->increment_reference(*this);
+			return orbit_uid_factory::acquire()->increment_reference(*this);
 		}
 
 		size_t 
 		_orbit_uid_class::reference_count(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
-			return orbit::acquire()->acquire_uid_factory()->reference_count(*this);
+			return orbit_uid_factory::acquire()->reference_count(*this);
 		}
 
+		#define UID_CACHE_LEN 0x40
+
+		#define UID_SLOT_COUNT(_SLOT_) ((uint32_t) ((_SLOT_) & UINT32_MAX))
+		#define UID_SLOT_GENERATION(_SLOT_) ((uint32_t) ((_SLOT_) >> 32))
+		#define UID_SLOT_MAKE(_GENERATION_, _COUNT_) \
+			((((uint64_t) ((_GENERATION_) & UID_GENERATION_MASK)) << 32) | (uint32_t) (_COUNT_))
+
+		typedef struct _orbit_uid_cache {
+
+			_orbit_uid_cache(void) :
+				epoch(0),
+				range(0)
+			{
+				return;
+			}
+
+			~_orbit_uid_cache(void)
+			{
+
+				if(!entry.empty() && orbit_uid_factory::is_allocated()) {
+					orbit_uid_factory::acquire()->release_cache(entry, epoch, range);
+				}
+			}
+
+			uint32_t epoch;
+			std::deque<uint32_t> entry;
+			uint32_t range;
+		} orbit_uid_cache;
+
+		static thread_local orbit_uid_cache uid_cache;
+
 		orbit_uid_factory_ptr orbit_uid_factory::m_instance = NULL;
 
 		_orbit_uid_factory::_orbit_uid_factory(void) :
-			m_initialized(false)
+			m_epoch(0),
+			m_initialized(false),
+			m_range(NULL),
+			m_range_count(0),
+			m_range_length(0),
+			m_size(0)
 		{
+			size_t iter;
+
+			for(iter = 0; iter < UID_CHUNK_COUNT; ++iter) {
+				m_slot[iter] = NULL;
+			}
+
 			std::atexit(orbit_uid_factory::_delete);
 		}
 
 		_orbit_uid_factory::~_orbit_uid_factory(void)
 		{
+			size_t iter;
 
 			if(m_initialized) {
 				uninitialize();
 			}
+
+			for(iter = 0; iter < UID_CHUNK_COUNT; ++iter) {
+				delete [] m_slot[iter].exchange(NULL);
+			}
 		}
 
 		void 
@@ -239,18 +294,42 @@ namespace ORBIT {
 			return orbit_uid_factory::m_instance;
 		}
 
+		void 
+		_orbit_uid_factory::cache_refresh(void)
+		{
+
+			if(uid_cache.epoch != m_epoch) {
+				uid_cache.entry.clear();
+				uid_cache.epoch = m_epoch;
+				uid_cache.range = 0;
+			}
+		}
+
 		bool 
 		_orbit_uid_factory::contains(
 			__in const orbit_uid &uid
 			)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
+			uint64_t value;
+			std::atomic<uint64_t> *entry;
 
 			if(!m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
 			}
 
-			return (m_map_uid.find(uid) != m_map_uid.end());
+			if(uid.m_uid == UID_INVALID) {
+				return false;
+			}
+
+			entry = slot(uid.index(), false);
+			if(!entry) {
+				return false;
+			}
+
+			value = entry->load(std::memory_order_acquire);
+
+			return ((UID_SLOT_GENERATION(value) == uid.generation())
+				&& (UID_SLOT_COUNT(value) >= REFERENCE_INIT));
 		}
 
 		size_t 
@@ -258,99 +337,270 @@ namespace ORBIT {
 			__in const orbit_uid &uid
 			)
 		{
-			size_t result;
-			std::map<orbit_uid, size_t>::iterator iter;
-
-			SERIALIZE_CALL_RECUR(m_lock);
+			uint32_t count;
 
 			if(!m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
 			}
 
-			iter = find(uid);
-			result = --iter->second;
-			if(result < REFERENCE_INIT) {
-				m_set_uid.insert(iter->first.m_uid);
-				m_map_uid.erase(iter);
+			if(!drop(uid, count)) {
+				THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_NOT_FOUND, 
+					"{%x}", uid.m_uid);
 			}
 
-			return result;
+			if(count < REFERENCE_INIT) {
+				release(uid);
+			}
+
+			return count;
+		}
+
+		bool 
+		_orbit_uid_factory::drop(
+			__in const orbit_uid &uid,
+			__out uint32_t &count
+			)
+		{
+			uint64_t result, value;
+			std::atomic<uint64_t> *entry = NULL;
+
+			if(uid.m_uid != UID_INVALID) {
+				entry = slot(uid.index(), false);
+			}
+
+			if(!entry) {
+				return false;
+			}
+
+			value = entry->load(std::memory_order_acquire);
+
+			do {
+
+				count = UID_SLOT_COUNT(value);
+				if((UID_SLOT_GENERATION(value) != uid.generation()) || (count < REFERENCE_INIT)) {
+					return false;
+				}
+
+				result = ((count - 1) < REFERENCE_INIT) ? UID_SLOT_MAKE(uid.generation() + 1, 0)
+					: (value - 1);
+			} while(!entry->compare_exchange_weak(value, result, std::memory_order_acq_rel));
+
+			--count;
+
+			return true;
 		}
 
-		std::map<orbit_uid, size_t>::iterator 
+		std::atomic<uint64_t> &
 		_orbit_uid_factory::find(
 			__in const orbit_uid &uid
 			)
 		{
-			std::map<orbit_uid, size_t>::iterator result;
-
-			SERIALIZE_CALL_RECUR(m_lock);
+			uint64_t value;
+			std::atomic<uint64_t> *result = NULL;
 
 			if(!m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
 			}
 
-			result = m_map_uid.find(uid);
-			if(result == m_map_uid.end()) {
+			if(uid.m_uid != UID_INVALID) {
+				result = slot(uid.index(), false);
+			}
+
+			if(result) {
+				value = result->load(std::memory_order_acquire);
+
+				if((UID_SLOT_GENERATION(value) != uid.generation()) 
+						|| (UID_SLOT_COUNT(value) < REFERENCE_INIT)) {
+					result = NULL;
+				}
+			}
+
+			if(!result) {
 				THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_NOT_FOUND, 
 					"{%x}", uid.m_uid);
 			}
 
-			return result;
+			return *result;
 		}
 
 		orbit_uid 
 		_orbit_uid_factory::generate(void)
 		{
+			size_t count;
+			uint64_t value;
 			orbit_uid result;
-
-			SERIALIZE_CALL_RECUR(m_lock);
+			uint32_t index, limit;
+			std::atomic<uint64_t> *entry;
 
 			if(!m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
 			}
 
-			if(!m_set_uid.empty()) {
-				result.uid() = *m_set_uid.begin();
-				m_set_uid.erase(result.uid());
-			} else if(m_next_uid != UID_INVALID) {
-				result.uid() = m_next_uid++;
+			cache_refresh();
+
+			orbit_uid_range &range = m_range[uid_cache.range];
+
+			if(uid_cache.entry.empty()) {
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				count = std::min((size_t) (UID_CACHE_LEN / 2), range.free.size());
+				if(count) {
+					uid_cache.entry.insert(uid_cache.entry.end(), range.free.begin(), 
+						range.free.begin() + count);
+					range.free.erase(range.free.begin(), range.free.begin() + count);
+				}
+			}
+
+			if(!uid_cache.entry.empty()) {
+				index = uid_cache.entry.front();
+				uid_cache.entry.pop_front();
 			} else {
-				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_INSUFFICENT);
+				limit = (uid_cache.range + 1) * m_range_length;
+
+				index = range.next.fetch_add(1, std::memory_order_relaxed);
+				if(index >= limit) {
+					range.next = limit;
+					THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_INSUFFICENT);
+				}
 			}
 
-			m_map_uid.insert(std::pair<orbit_uid, size_t>(result, REFERENCE_INIT));
+			entry = slot(index, true);
+			value = entry->load(std::memory_order_acquire);
+			entry->store(UID_SLOT_MAKE(UID_SLOT_GENERATION(value), REFERENCE_INIT), 
+				std::memory_order_release);
+			result.m_uid = UID_MAKE(index, UID_SLOT_GENERATION(value));
+			++m_size;
 
 			return result;
 		}
 
+		void 
+		_orbit_uid_factory::generate_n(
+			__in size_t count,
+			__out std::vector<orbit_uid> &uid
+			)
+		{
+			size_t length;
+			uint64_t value;
+			std::deque<uint32_t> index;
+			std::deque<uint32_t>::iterator iter_index;
+			uint32_t iter, limit, next = 0, reserve = 0;
+
+			if(!m_initialized) {
+				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
+			}
+
+			cache_refresh();
+
+			orbit_uid_range &range = m_range[uid_cache.range];
+
+			length = std::min(count, uid_cache.entry.size());
+			index.insert(index.end(), uid_cache.entry.begin(), uid_cache.entry.begin() + length);
+			uid_cache.entry.erase(uid_cache.entry.begin(), uid_cache.entry.begin() + length);
+
+			if(index.size() < count) {
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				length = std::min(count - index.size(), range.free.size());
+				index.insert(index.end(), range.free.begin(), range.free.begin() + length);
+				range.free.erase(range.free.begin(), range.free.begin() + length);
+			}
+
+			if(index.size() < count) {
+				limit = (uid_cache.range + 1) * m_range_length;
+				reserve = count - index.size();
+				next = range.next.load(std::memory_order_relaxed);
+
+				do {
+
+					if((next >= limit) || (reserve > (limit - next))) {
+						uid_cache.entry.insert(uid_cache.entry.begin(), index.begin(), index.end());
+						THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_INSUFFICENT, 
+							"%zu", count);
+					}
+				} while(!range.next.compare_exchange_weak(next, next + reserve, 
+					std::memory_order_relaxed));
+			}
+
+			uid.reserve(uid.size() + count);
+
+			for(iter_index = index.begin(); iter_index != index.end(); ++iter_index) {
+				std::atomic<uint64_t> &entry = *slot(*iter_index, true);
+
+				value = entry.load(std::memory_order_acquire);
+				entry.store(UID_SLOT_MAKE(UID_SLOT_GENERATION(value), REFERENCE_INIT), 
+					std::memory_order_release);
+				uid.push_back(orbit_uid(UID_MAKE(*iter_index, UID_SLOT_GENERATION(value))));
+			}
+
+			for(iter = next; reserve && (iter < (next + reserve)); ++iter) {
+				slot(iter, true)->store(UID_SLOT_MAKE(0, REFERENCE_INIT), std::memory_order_release);
+				uid.push_back(orbit_uid(UID_MAKE(iter, 0)));
+			}
+
+			m_size += count;
+		}
+
 		size_t 
 		_orbit_uid_factory::increment_reference(
 			__in const orbit_uid &uid
 			)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
+			uint64_t value;
 
 			if(!m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
 			}
 
-			return ++find(uid)->second;
+			std::atomic<uint64_t> &entry = find(uid);
+
+			value = entry.load(std::memory_order_acquire);
+
+			do {
+
+				if((UID_SLOT_GENERATION(value) != uid.generation()) 
+						|| (UID_SLOT_COUNT(value) < REFERENCE_INIT)) {
+					THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_NOT_FOUND, 
+						"{%x}", uid.m_uid);
+				}
+			} while(!entry.compare_exchange_weak(value, value + 1, std::memory_order_acq_rel));
+
+			return (UID_SLOT_COUNT(value) + 1);
 		}
 
 		void 
-		_orbit_uid_factory::initialize(void)
+		_orbit_uid_factory::initialize(
+			__in_opt uint32_t ranges
+			)
 		{
+			uint32_t iter;
+
 			SERIALIZE_CALL_RECUR(m_lock);
 
 			if(m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_INITIALIZE);
 			}
 
+			if(!ranges || (ranges > UID_RANGE_MAX)) {
+				THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_INSUFFICENT, 
+					"%u", ranges);
+			}
+
+			m_range = new orbit_uid_range[ranges];
+			if(!m_range) {
+				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_ALLOCATION);
+			}
+
+			m_range_count = ranges;
+			m_range_length = UID_INDEX_MASK / ranges;
+
+			for(iter = 0; iter < ranges; ++iter) {
+				m_range[iter].next = (iter * m_range_length);
+			}
+
+			++m_epoch;
+			m_size = 0;
 			m_initialized = true;
-			m_map_uid.clear();
-			m_next_uid = 0;
-			m_set_uid.clear();
 		}
 
 		bool 
@@ -362,34 +612,279 @@ namespace ORBIT {
 		bool 
 		_orbit_uid_factory::is_initialized(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 			return m_initialized;
 		}
 
+		uint32_t 
+		_orbit_uid_factory::range(
+			__in const orbit_uid &uid
+			)
+		{
+
+			if(!m_initialized) {
+				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(uid.m_uid == UID_INVALID) {
+				THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_NOT_FOUND, 
+					"{%x}", uid.m_uid);
+			}
+
+			return std::min(uid.index() / m_range_length, m_range_count - 1);
+		}
+
+		uint32_t 
+		_orbit_uid_factory::range_count(void)
+		{
+
+			if(!m_initialized) {
+				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
+			}
+
+			return m_range_count;
+		}
+
+		uint32_t 
+		_orbit_uid_factory::range_select(
+			__in uint32_t range
+			)
+		{
+			uint32_t result;
+
+			if(!m_initialized) {
+				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
+			}
+
+			if(range >= m_range_count) {
+				THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_NOT_FOUND, 
+					"%u", range);
+			}
+
+			cache_refresh();
+
+			result = uid_cache.range;
+			if(range != result) {
+
+				if(!uid_cache.entry.empty()) {
+					SERIALIZE_CALL_RECUR(m_lock);
+
+					std::deque<uint32_t> &free = m_range[result].free;
+					free.insert(free.end(), uid_cache.entry.begin(), uid_cache.entry.end());
+					uid_cache.entry.clear();
+				}
+
+				uid_cache.range = range;
+			}
+
+			return result;
+		}
+
 		size_t 
 		_orbit_uid_factory::reference_count(
 			__in const orbit_uid &uid
 			)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
+			int error;
+			size_t result;
+
+			result = reference_count(uid, error);
+			if(error == EINVAL) {
+				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
+			} else if(error) {
+				THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_NOT_FOUND, 
+					"{%x}", uid.m_uid);
+			}
+
+			return result;
+		}
+
+		size_t 
+		_orbit_uid_factory::reference_count(
+			__in const orbit_uid &uid,
+			__out int &error
+			)
+		{
+			uint64_t value;
+			std::atomic<uint64_t> *entry = NULL;
+
+			error = 0;
+
+			if(!m_initialized) {
+				error = EINVAL;
+				return 0;
+			}
+
+			if(uid.m_uid != UID_INVALID) {
+				entry = slot(uid.index(), false);
+			}
+
+			if(entry) {
+				value = entry->load(std::memory_order_acquire);
+
+				if((UID_SLOT_GENERATION(value) == uid.generation()) 
+						&& (UID_SLOT_COUNT(value) >= REFERENCE_INIT)) {
+					return UID_SLOT_COUNT(value);
+				}
+			}
+
+			error = ENOENT;
+
+			return 0;
+		}
+
+		void 
+		_orbit_uid_factory::release(
+			__in const orbit_uid &uid
+			)
+		{
+			size_t count;
+			uint32_t owner;
+
+			--m_size;
+
+			if(uid.generation() == UID_GENERATION_MASK) {
+				return;
+			}
+
+			cache_refresh();
+
+			owner = range(uid);
+			if(owner != uid_cache.range) {
+				SERIALIZE_CALL_RECUR(m_lock);
+				m_range[owner].free.push_back(uid.index());
+				return;
+			}
+
+			if(uid_cache.entry.size() >= UID_CACHE_LEN) {
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				std::deque<uint32_t> &free = m_range[owner].free;
+				count = UID_CACHE_LEN / 2;
+				free.insert(free.end(), uid_cache.entry.begin(), uid_cache.entry.begin() + count);
+				uid_cache.entry.erase(uid_cache.entry.begin(), uid_cache.entry.begin() + count);
+			}
+
+			uid_cache.entry.push_back(uid.index());
+		}
+
+		size_t 
+		_orbit_uid_factory::release_n(
+			__in const std::vector<orbit_uid> &uid
+			)
+		{
+			size_t length, result = 0;
+			uint32_t count, owner;
+			const orbit_uid *invalid = NULL;
+			std::vector<orbit_uid>::const_iterator iter;
 
 			if(!m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
 			}
 
-			return find(uid)->second;
+			cache_refresh();
+
+			for(iter = uid.begin(); iter != uid.end(); ++iter) {
+
+				if(!drop(*iter, count)) {
+
+					if(!invalid) {
+						invalid = &*iter;
+					}
+
+					continue;
+				}
+
+				if(count < REFERENCE_INIT) {
+
+					if(iter->generation() != UID_GENERATION_MASK) {
+
+						owner = range(*iter);
+						if(owner == uid_cache.range) {
+							uid_cache.entry.push_back(iter->index());
+						} else {
+							SERIALIZE_CALL_RECUR(m_lock);
+							m_range[owner].free.push_back(iter->index());
+						}
+					}
+
+					++result;
+				}
+			}
+
+			m_size -= result;
+
+			if(uid_cache.entry.size() > UID_CACHE_LEN) {
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				std::deque<uint32_t> &free = m_range[uid_cache.range].free;
+				length = uid_cache.entry.size() - (UID_CACHE_LEN / 2);
+				free.insert(free.end(), uid_cache.entry.begin(), uid_cache.entry.begin() + length);
+				uid_cache.entry.erase(uid_cache.entry.begin(), uid_cache.entry.begin() + length);
+			}
+
+			if(invalid) {
+				THROW_ORBIT_UID_EXCEPTION_MESSAGE(ORBIT_UID_EXCEPTION_NOT_FOUND, 
+					"{%x}", invalid->m_uid);
+			}
+
+			return result;
+		}
+
+		void 
+		_orbit_uid_factory::release_cache(
+			__inout std::deque<uint32_t> &cache,
+			__in uint32_t epoch,
+			__in uint32_t range
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_initialized && (epoch == m_epoch) && (range < m_range_count)) {
+				m_range[range].free.insert(m_range[range].free.end(), cache.begin(), cache.end());
+			}
+
+			cache.clear();
 		}
 
 		size_t 
 		_orbit_uid_factory::size(void)
 		{
-			SERIALIZE_CALL_RECUR(m_lock);
 
 			if(!m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
 			}
 
-			return m_map_uid.size();
+			return m_size;
+		}
+
+		std::atomic<uint64_t> *
+		_orbit_uid_factory::slot(
+			__in uint32_t index,
+			__in bool allocate
+			)
+		{
+			std::atomic<uint64_t> *chunk, *expected = NULL;
+			std::atomic<std::atomic<uint64_t> *> &entry = m_slot[UID_INDEX(index) >> UID_CHUNK_SHIFT];
+
+			chunk = entry.load(std::memory_order_acquire);
+			if(!chunk) {
+
+				if(!allocate) {
+					return NULL;
+				}
+
+				chunk = new std::atomic<uint64_t>[UID_CHUNK_LEN]();
+				if(!chunk) {
+					THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_ALLOCATION);
+				}
+
+				if(!entry.compare_exchange_strong(expected, chunk, std::memory_order_acq_rel)) {
+					delete [] chunk;
+					chunk = expected;
+				}
+			}
+
+			return &chunk[index & (UID_CHUNK_LEN - 1)];
 		}
 
 		std::string 
@@ -397,11 +892,11 @@ namespace ORBIT {
 			__in_opt bool verbose
 			)
 		{
-			size_t index = 1;
+			uint64_t value;
+			size_t position = 1;
 			std::stringstream result;
-			std::map<orbit_uid, size_t>::iterator iter;
-
-			SERIALIZE_CALL_RECUR(m_lock);
+			std::atomic<uint64_t> *entry;
+			uint32_t iter, iter_range, next;
 
 			result << "[" << (m_initialized ? "INIT" : "UNINIT") << "] " 
 				<< ORBIT_UID_HEADER;
@@ -410,10 +905,28 @@ namespace ORBIT {
 				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
 			}
 
-			for(iter = m_map_uid.begin(); iter != m_map_uid.end(); ++index, ++iter) {
-				result << std::endl << "--- [" << index << "/" << m_map_uid.size() << "] {"
-					<< VALUE_AS_HEX(orbit_uid_t, iter->first.m_uid) << "}, ref: "
-					<< iter->second;
+			if(m_initialized) {
+
+				for(iter_range = 0; iter_range < m_range_count; ++iter_range) {
+					next = std::min(m_range[iter_range].next.load(), 
+						(iter_range + 1) * m_range_length);
+
+					for(iter = (iter_range * m_range_length); iter < next; ++iter) {
+
+						entry = slot(iter, false);
+						if(!entry) {
+							iter |= (UID_CHUNK_LEN - 1);
+							continue;
+						}
+
+						value = entry->load(std::memory_order_acquire);
+						if(UID_SLOT_COUNT(value) >= REFERENCE_INIT) {
+							result << std::endl << "--- [" << position++ << "/" << m_size << "] {"
+								<< VALUE_AS_HEX(orbit_uid_t, UID_MAKE(iter, UID_SLOT_GENERATION(value))) 
+								<< "}, ref: " << UID_SLOT_COUNT(value);
+						}
+					}
+				}
 			}
 
 			return CHECK_STR(result.str());
@@ -422,16 +935,35 @@ namespace ORBIT {
 		void 
 		_orbit_uid_factory::uninitialize(void)
 		{
+			size_t iter, iter_slot;
+			std::atomic<uint64_t> *chunk;
+
 			SERIALIZE_CALL_RECUR(m_lock);
 
 			if(!m_initialized) {
 				THROW_ORBIT_UID_EXCEPTION(ORBIT_UID_EXCEPTION_UNINITIALIZE);
 			}
 
-			m_map_uid.clear();
-			m_next_uid = 0;
-			m_set_uid.clear();
 			m_initialized = false;
+
+			for(iter = 0; iter < UID_CHUNK_COUNT; ++iter) {
+
+				chunk = m_slot[iter].load(std::memory_order_acquire);
+				if(!chunk) {
+					continue;
+				}
+
+				for(iter_slot = 0; iter_slot < UID_CHUNK_LEN; ++iter_slot) {
+					chunk[iter_slot].store(0, std::memory_order_release);
+				}
+			}
+
+			delete [] m_range;
+			m_range = NULL;
+			m_range_count = 0;
+			m_range_length = 0;
+			++m_epoch;
+			m_size = 0;
 		}
 	}
 }
@@ -0,0 +1,1252 @@
+/**
+ * liborbit
+ * Copyright (C) 2015 David Jolly
+ * ----------------------
+ *
+ * liborbit is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liborbit is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <random>
+#include <string.h>
+#include <time.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "../include/orbit.h"
+#include "../include/orbit_utp_type.h"
+
+namespace ORBIT {
+
+	namespace COMPONENT {
+
+		#define UTP_CLOSE_TIMEOUT 2000
+		#define UTP_DELAY_WINDOW 60000000
+		#define UTP_DUPLICATE_MAX 3
+		#define UTP_GAIN 3000
+		#define UTP_NSEC_PER_USEC 1000
+		#define UTP_PACKET_LEN 0x578
+		#define UTP_RECEIVE_LEN 0x100000
+		#define UTP_RTO_INIT 1000000
+		#define UTP_RTO_MAX 60000000
+		#define UTP_RTO_MIN 500000
+		#define UTP_SEND_LEN 0x100000
+		#define UTP_SEQUENCE_HALF 0x8000
+		#define UTP_TARGET 100000
+		#define UTP_TICK 50
+		#define UTP_TRANSMISSION_MAX 8
+		#define UTP_USEC_PER_MSEC 1000
+		#define UTP_USEC_PER_SEC 1000000
+		#define UTP_VERSION 1
+		#define UTP_WINDOW_INIT (UTP_PACKET_LEN * 2)
+		#define UTP_WINDOW_MAX 0x100000
+		#define UTP_WINDOW_MIN UTP_PACKET_LEN
+
+		static const std::string ORBIT_UTP_STATE_STR[] = {
+			"NONE", "SYN_SENT", "CONNECTED", "FIN_SENT", "RESET",
+			};
+
+		#define ORBIT_UTP_STATE_STRING(_TYPE_) \
+			((_TYPE_) > ORBIT_UTP_STATE_MAX ? UNKNOWN : \
+			CHECK_STR(ORBIT_UTP_STATE_STR[_TYPE_]))
+
+		static bool 
+		utp_before(
+			__in uint16_t left,
+			__in uint16_t right
+			)
+		{
+			uint16_t distance = right - left;
+
+			return (distance && (distance < UTP_SEQUENCE_HALF));
+		}
+
+		static uint16_t 
+		utp_random(void)
+		{
+			static std::random_device device;
+
+			return (uint16_t) device();
+		}
+
+		static uint64_t 
+		utp_time(void)
+		{
+			timespec now;
+
+			clock_gettime(CLOCK_MONOTONIC, &now);
+
+			return ((uint64_t) now.tv_sec * UTP_USEC_PER_SEC) 
+				+ (now.tv_nsec / UTP_NSEC_PER_USEC);
+		}
+
+		_orbit_utp::_orbit_utp(void) :
+			m_descriptor(0),
+			m_event(NULL),
+			m_initialized(false),
+			m_timer(TIMER_INVALID)
+		{
+			return;
+		}
+
+		_orbit_utp::~_orbit_utp(void)
+		{
+
+			if(m_initialized) {
+				uninitialize();
+			}
+		}
+
+		void 
+		_orbit_utp::accept(
+			__in const orbit_utp_accept_cb &callback
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_UNINITIALIZE);
+			}
+
+			m_accept = callback;
+		}
+
+		orbit_utp_connection_handle 
+		_orbit_utp::connect(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in const orbit_utp_connect_cb &complete,
+			__in_opt uint32_t timeout
+			)
+		{
+			orbit_event_ptr event;
+			orbit_resolver_address_t address;
+			std::weak_ptr<bool> guard;
+			orbit_utp_connection_handle result = std::make_shared<orbit_utp_connection>();
+			orbit_resolver_ptr resolver = orbit::acquire()->acquire_resolver();
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_UNINITIALIZE);
+			}
+
+			result->m_connect = complete;
+			result->m_connect_deadline = utp_time() + ((uint64_t) timeout * UTP_USEC_PER_MSEC);
+
+			if(resolver->lookup(host, address)) {
+				connect_start(result, port, 0, address);
+				return result;
+			}
+
+			event = m_event;
+			guard = m_guard;
+			resolver->resolve(host, [this, event, guard, port, result](const std::string &host, int error, 
+					const orbit_resolver_address_t &address) {
+				UNREFERENCE_PARAM(host);
+
+				if(!guard.expired() && event->is_initialized()) {
+					event->post([this, guard, port, result, error, address](void) {
+
+							if(!guard.expired()) {
+								connect_start(result, port, error, address);
+							}
+						});
+				}
+			});
+
+			return result;
+		}
+
+		void 
+		_orbit_utp::connect_fail(
+			__in const orbit_utp_connection_handle &connection,
+			__in int error
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			{
+				std::lock_guard<std::recursive_mutex> lock(connection->m_lock);
+
+				connection->m_connect_error = error;
+				connection->m_state = ORBIT_UTP_STATE_RESET;
+			}
+
+			m_event->post([connection](void) {
+					connection->notify(connection, ORBIT_EVENT_HANGUP);
+				});
+		}
+
+		void 
+		_orbit_utp::connect_start(
+			__in const orbit_utp_connection_handle &connection,
+			__in uint16_t port,
+			__in int error,
+			__in const orbit_resolver_address_t &address
+			)
+		{
+			uint16_t receive;
+			orbit_utp_key identifier;
+			sockaddr_storage peer;
+			socklen_t length = 0;
+			orbit_socket_family_t family;
+			orbit_resolver_address_t::const_iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				return;
+			}
+
+			{
+				std::lock_guard<std::recursive_mutex> lock(connection->m_lock);
+
+				if(connection->m_closing) {
+					return;
+				}
+			}
+
+			if(error) {
+				connect_fail(connection, EHOSTUNREACH);
+				return;
+			}
+
+			family = m_socket.family();
+			memset(&peer, 0, sizeof(peer));
+
+			for(iter = address.begin(); iter != address.end(); ++iter) {
+
+				if((iter->ss_family == AF_INET) && (family == ORBIT_SOCKET_FAMILY_TYPE_IPV4)) {
+					memcpy(&peer, &(*iter), sizeof(sockaddr_in));
+					((sockaddr_in *) &peer)->sin_port = htons(port);
+					length = sizeof(sockaddr_in);
+					break;
+				} else if((iter->ss_family == AF_INET6) && (family == ORBIT_SOCKET_FAMILY_TYPE_IPV6)) {
+					memcpy(&peer, &(*iter), sizeof(sockaddr_in6));
+					((sockaddr_in6 *) &peer)->sin6_port = htons(port);
+					length = sizeof(sockaddr_in6);
+					break;
+				} else if((iter->ss_family == AF_INET) && (family == ORBIT_SOCKET_FAMILY_TYPE_IPV6)) {
+					((sockaddr_in6 *) &peer)->sin6_family = AF_INET6;
+					((sockaddr_in6 *) &peer)->sin6_addr.s6_addr[10] = 0xff;
+					((sockaddr_in6 *) &peer)->sin6_addr.s6_addr[11] = 0xff;
+					memcpy(&((sockaddr_in6 *) &peer)->sin6_addr.s6_addr[12], 
+						&((const sockaddr_in *) &(*iter))->sin_addr, sizeof(in_addr));
+					((sockaddr_in6 *) &peer)->sin6_port = htons(port);
+					length = sizeof(sockaddr_in6);
+					break;
+				}
+			}
+
+			if(iter == address.end()) {
+				connect_fail(connection, EAFNOSUPPORT);
+				return;
+			}
+
+			do {
+				receive = utp_random();
+				key(peer, receive, identifier);
+			} while(m_connection.find(identifier) != m_connection.end());
+
+			{
+				std::lock_guard<std::recursive_mutex> lock(connection->m_lock);
+
+				connection->m_connection_receive = receive;
+				connection->m_connection_send = receive + 1;
+				connection->m_owner = this;
+				connection->m_peer = peer;
+				connection->m_peer_length = length;
+				connection->m_sequence = 1;
+				connection->m_state = ORBIT_UTP_STATE_SYN_SENT;
+				connection->send(ORBIT_UTP_PACKET_SYN);
+			}
+
+			m_connection[identifier] = connection;
+		}
+
+		void 
+		_orbit_utp::dispatch(void)
+		{
+			uint8_t type;
+			uint16_t identifier;
+			orbit_utp_key entry;
+			orbit_utp_accept_cb accept;
+			orbit_utp_header header;
+			orbit_utp_connection_handle connection;
+			std::vector<orbit_utp_connection_handle> accepted;
+			std::vector<orbit_utp_connection_handle>::iterator iter_accepted;
+			std::map<orbit_utp_connection_handle, uint32_t> notify;
+			std::map<orbit_utp_connection_handle, uint32_t>::iterator iter_notify;
+			std::map<orbit_utp_key, orbit_utp_connection_handle>::iterator iter_connection;
+			std::vector<orbit_socket_datagram>::iterator iter;
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				if(!m_initialized) {
+					return;
+				}
+
+				while(m_socket.read_batch(m_batch) != SOCKET_AGAIN) {
+
+					for(iter = m_batch.begin(); iter != m_batch.end(); ++iter) {
+
+						if(iter->truncated || (iter->data.size() < sizeof(header))) {
+							continue;
+						}
+
+						memcpy(&header, &iter->data[0], sizeof(header));
+
+						type = header.type >> 4;
+						if(((header.type & 0xf) != UTP_VERSION) || (type > ORBIT_UTP_PACKET_MAX)) {
+							continue;
+						}
+
+						identifier = ntohs(header.connection);
+						if(type == ORBIT_UTP_PACKET_SYN) {
+							++identifier;
+						}
+
+						if(!key(iter->address, identifier, entry)) {
+							continue;
+						}
+
+						iter_connection = m_connection.find(entry);
+
+						if((iter_connection == m_connection.end()) && (type == ORBIT_UTP_PACKET_RESET)) {
+							entry.second = identifier + 1;
+							iter_connection = m_connection.find(entry);
+
+							if(iter_connection == m_connection.end()) {
+								entry.second = identifier - 1;
+								iter_connection = m_connection.find(entry);
+							}
+						}
+
+						if(iter_connection != m_connection.end()) {
+							notify[iter_connection->second] |= iter_connection->second->handle(header, 
+								&iter->data[sizeof(header)], iter->data.size() - sizeof(header));
+						} else if((type == ORBIT_UTP_PACKET_SYN) && m_accept) {
+							connection = std::make_shared<orbit_utp_connection>();
+
+							std::lock_guard<std::recursive_mutex> lock(connection->m_lock);
+
+							connection->m_acknowledge = ntohs(header.sequence);
+							connection->m_connection_receive = identifier;
+							connection->m_connection_send = ntohs(header.connection);
+							connection->m_owner = this;
+							connection->m_peer = iter->address;
+							connection->m_peer_length = iter->length;
+							connection->m_sequence = utp_random();
+							connection->m_state = ORBIT_UTP_STATE_CONNECTED;
+							connection->m_timestamp_difference = (uint32_t) utp_time()
+								- ntohl(header.timestamp);
+							connection->m_window_peer = ntohl(header.window);
+							connection->send(ORBIT_UTP_PACKET_STATE);
+							m_connection[entry] = connection;
+							accepted.push_back(connection);
+						} else if((type == ORBIT_UTP_PACKET_DATA) || (type == ORBIT_UTP_PACKET_FIN)) {
+							reset(*iter, header);
+						}
+					}
+				}
+
+				accept = m_accept;
+			}
+
+			for(iter_accepted = accepted.begin(); iter_accepted != accepted.end(); ++iter_accepted) {
+				accept(*iter_accepted);
+			}
+
+			for(iter_notify = notify.begin(); iter_notify != notify.end(); ++iter_notify) {
+
+				if(iter_notify->second) {
+					iter_notify->first->notify(iter_notify->first, iter_notify->second);
+				}
+			}
+		}
+
+		void 
+		_orbit_utp::initialize(
+			__in const std::string &host,
+			__in uint16_t port,
+			__in_opt orbit_event_ptr event
+			)
+		{
+			int value = UTP_RECEIVE_LEN;
+			std::weak_ptr<bool> guard;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_initialized) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_INITIALIZE);
+			}
+
+			if(!event) {
+				event = orbit::acquire()->acquire_socket_factory()->acquire_event();
+			}
+
+			if(!event->is_initialized()) {
+				THROW_ORBIT_UTP_EXCEPTION_MESSAGE(ORBIT_UTP_EXCEPTION_INTERNAL,
+					"%s", "Event is uninitialized");
+			}
+
+			m_socket.open_udp(host, port);
+			m_socket.set_blocking(false);
+
+			if((setsockopt(m_socket.descriptor(), SOL_SOCKET, SO_RCVBUF, &value, sizeof(value)) < 0)
+					|| (setsockopt(m_socket.descriptor(), SOL_SOCKET, SO_SNDBUF, &value, sizeof(value)) < 0)) {
+				value = errno;
+				m_socket.close();
+				THROW_ORBIT_UTP_EXCEPTION_MESSAGE(ORBIT_UTP_EXCEPTION_INTERNAL,
+					"[%s] %s", CONCAT_STR(setsockopt), strerror(value));
+			}
+
+			m_descriptor = m_socket.descriptor();
+			m_event = event;
+			m_guard = std::make_shared<bool>(true);
+			guard = m_guard;
+			m_event->add(m_descriptor, ORBIT_EVENT_READ, [this, guard](int descriptor, uint32_t events) {
+				UNREFERENCE_PARAM(descriptor);
+				UNREFERENCE_PARAM(events);
+
+				if(!guard.expired()) {
+					dispatch();
+				}
+			});
+
+			m_timer = m_event->timer_add(UTP_TICK, [this, guard](orbit_timer_t timer) {
+				UNREFERENCE_PARAM(timer);
+
+				if(!guard.expired()) {
+					tick();
+				}
+			});
+
+			m_initialized = true;
+		}
+
+		bool 
+		_orbit_utp::is_initialized(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_initialized;
+		}
+
+		bool 
+		_orbit_utp::key(
+			__in const sockaddr_storage &address,
+			__in uint16_t connection,
+			__out orbit_utp_key &result
+			)
+		{
+
+			switch(address.ss_family) {
+				case AF_INET:
+					result.first.assign((const char *) &((const sockaddr_in *) &address)->sin_addr, 
+						sizeof(in_addr));
+					result.first.append((const char *) &((const sockaddr_in *) &address)->sin_port, 
+						sizeof(in_port_t));
+					break;
+				case AF_INET6:
+					result.first.assign((const char *) &((const sockaddr_in6 *) &address)->sin6_addr, 
+						sizeof(in6_addr));
+					result.first.append((const char *) &((const sockaddr_in6 *) &address)->sin6_port, 
+						sizeof(in_port_t));
+					break;
+				default:
+					return false;
+			}
+
+			result.second = connection;
+
+			return true;
+		}
+
+		uint16_t 
+		_orbit_utp::port(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_UNINITIALIZE);
+			}
+
+			return m_socket.port();
+		}
+
+		void 
+		_orbit_utp::reset(
+			__in const orbit_socket_datagram &datagram,
+			__in const orbit_utp_header &header
+			)
+		{
+			orbit_utp_header response;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			memset(&response, 0, sizeof(response));
+			response.type = (ORBIT_UTP_PACKET_RESET << 4) | UTP_VERSION;
+			response.connection = header.connection;
+			response.timestamp = htonl((uint32_t) utp_time());
+			response.acknowledge = header.sequence;
+			transmit(datagram.address, datagram.length, (const uint8_t *) &response, sizeof(response));
+		}
+
+		size_t 
+		_orbit_utp::size(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_connection.size();
+		}
+
+		void 
+		_orbit_utp::tick(void)
+		{
+			uint32_t events;
+			std::weak_ptr<bool> guard;
+			uint64_t now = utp_time();
+			std::map<orbit_utp_connection_handle, uint32_t> notify;
+			std::map<orbit_utp_connection_handle, uint32_t>::iterator iter_notify;
+			std::map<orbit_utp_key, orbit_utp_connection_handle>::iterator iter;
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				if(!m_initialized) {
+					return;
+				}
+
+				guard = m_guard;
+				m_timer = m_event->timer_add(UTP_TICK, [this, guard](orbit_timer_t timer) {
+					UNREFERENCE_PARAM(timer);
+
+					if(!guard.expired()) {
+						tick();
+					}
+				});
+
+				for(iter = m_connection.begin(); iter != m_connection.end();) {
+
+					events = iter->second->timeout(now);
+					if(events) {
+						notify[iter->second] |= events;
+					}
+
+					if(iter->second->is_finished(now)) {
+						notify[iter->second] |= events;
+						iter->second->detach();
+						iter = m_connection.erase(iter);
+					} else {
+						++iter;
+					}
+				}
+			}
+
+			for(iter_notify = notify.begin(); iter_notify != notify.end(); ++iter_notify) {
+				iter_notify->first->notify(iter_notify->first, iter_notify->second);
+			}
+		}
+
+		std::string 
+		_orbit_utp::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << "[" << (m_initialized ? "INIT" : "UNINIT") << "] " << ORBIT_UTP_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			if(m_initialized) {
+				result << " [" << (m_accept ? "ACCEPT" : "CONNECT") << ", port: " << m_socket.port()
+					<< ", connection: " << m_connection.size() << "]";
+			}
+
+			return CHECK_STR(result.str());
+		}
+
+		int 
+		_orbit_utp::transmit(
+			__in const sockaddr_storage &address,
+			__in socklen_t length,
+			__in const uint8_t *input,
+			__in size_t size
+			)
+		{
+			ssize_t result;
+			int descriptor = m_descriptor;
+
+			if(!descriptor) {
+				return ENOTCONN;
+			}
+
+			do {
+				result = ::sendto(descriptor, input, size, MSG_DONTWAIT | MSG_NOSIGNAL, 
+					(const sockaddr *) &address, length);
+			} while((result < 0) && (errno == EINTR));
+
+			return ((result < 0) ? errno : 0);
+		}
+
+		void 
+		_orbit_utp::uninitialize(void)
+		{
+			std::map<orbit_utp_key, orbit_utp_connection_handle>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(!m_initialized) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_UNINITIALIZE);
+			}
+
+			m_guard.reset();
+
+			if(m_event->is_initialized()) {
+
+				if(m_event->timer_contains(m_timer)) {
+					m_event->timer_remove(m_timer);
+				}
+
+				if(m_event->contains(m_descriptor)) {
+					m_event->remove(m_descriptor);
+				}
+			}
+
+			for(iter = m_connection.begin(); iter != m_connection.end(); ++iter) {
+				iter->second->detach();
+			}
+
+			m_connection.clear();
+			m_descriptor = 0;
+			m_socket.close();
+			m_accept = nullptr;
+			m_batch.clear();
+			m_event = NULL;
+			m_timer = TIMER_INVALID;
+			m_initialized = false;
+		}
+
+		_orbit_utp_connection::_orbit_utp_connection(void) :
+			m_acknowledge(0),
+			m_acknowledge_duplicate(0),
+			m_blocked(false),
+			m_close_deadline(0),
+			m_closing(false),
+			m_connect_deadline(0),
+			m_connect_error(0),
+			m_connection_receive(0),
+			m_connection_send(0),
+			m_delay_time(utp_time()),
+			m_eof(false),
+			m_eof_sequence(0),
+			m_fin(false),
+			m_flight_length(0),
+			m_owner(NULL),
+			m_peer_length(0),
+			m_receive_offset(0),
+			m_recover(0),
+			m_recovering(false),
+			m_reorder_length(0),
+			m_rtt(0),
+			m_rtt_variance(0),
+			m_rto(UTP_RTO_INIT),
+			m_send_offset(0),
+			m_sequence(0),
+			m_state(ORBIT_UTP_STATE_NONE),
+			m_timestamp_difference(0),
+			m_window_max(UTP_WINDOW_INIT),
+			m_window_peer(UTP_WINDOW_MAX)
+		{
+			m_delay_base[0] = INVALID_TYPE(uint32_t);
+			m_delay_base[1] = INVALID_TYPE(uint32_t);
+			memset(&m_peer, 0, sizeof(m_peer));
+		}
+
+		_orbit_utp_connection::~_orbit_utp_connection(void)
+		{
+			return;
+		}
+
+		void 
+		_orbit_utp_connection::acknowledge(
+			__in uint16_t sequence,
+			__in uint32_t delay
+			)
+		{
+			double factor, target;
+			uint64_t now = utp_time();
+			size_t acknowledged = 0, payload;
+			int64_t difference, sample;
+			uint32_t base;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_flight.empty()) {
+				return;
+			}
+
+			while(!m_flight.empty() && !utp_before(sequence, m_flight.front().sequence)) {
+				orbit_utp_packet &packet = m_flight.front();
+
+				if(packet.transmissions == 1) {
+					sample = now - packet.time;
+
+					if(!m_rtt) {
+						m_rtt = sample;
+						m_rtt_variance = sample / 2;
+					} else {
+						difference = (int64_t) m_rtt - sample;
+						m_rtt_variance += ((difference < 0 ? -difference : difference) 
+							- (int64_t) m_rtt_variance) / 4;
+						m_rtt += (sample - (int64_t) m_rtt) / 8;
+					}
+				}
+
+				payload = packet.data.size() - sizeof(orbit_utp_header);
+				acknowledged += payload;
+				m_flight_length -= payload;
+				m_flight.pop_front();
+			}
+
+			if(!acknowledged) {
+
+				if(!m_recovering && !m_flight.empty() 
+						&& (sequence == (uint16_t) (m_flight.front().sequence - 1))
+						&& (++m_acknowledge_duplicate >= UTP_DUPLICATE_MAX)) {
+					m_acknowledge_duplicate = 0;
+					m_recover = m_sequence - 1;
+					m_recovering = true;
+					m_window_max = std::max(m_window_max / 2, (uint32_t) UTP_WINDOW_MIN);
+					send_packet(m_flight.front());
+				}
+
+				return;
+			}
+
+			m_acknowledge_duplicate = 0;
+
+			if(m_closing) {
+				m_close_deadline = now + ((uint64_t) UTP_CLOSE_TIMEOUT * UTP_USEC_PER_MSEC);
+			}
+
+			if(m_rtt) {
+				m_rto = std::max((uint64_t) (m_rtt + (4 * m_rtt_variance)), (uint64_t) UTP_RTO_MIN);
+			}
+
+			if(m_recovering) {
+
+				if(!m_flight.empty() && utp_before(sequence, m_recover)) {
+					send_packet(m_flight.front());
+				} else {
+					m_recovering = false;
+				}
+			}
+
+			if(!delay) {
+				return;
+			}
+
+			if((now - m_delay_time) > UTP_DELAY_WINDOW) {
+				m_delay_base[0] = m_delay_base[1];
+				m_delay_base[1] = delay;
+				m_delay_time = now;
+			}
+
+			m_delay_base[1] = std::min(m_delay_base[1], delay);
+			base = std::min(m_delay_base[0], m_delay_base[1]);
+
+			target = ((double) UTP_TARGET - (double) (delay - base)) / UTP_TARGET;
+			factor = (double) std::min(acknowledged, (size_t) m_window_max) 
+				/ std::max((size_t) m_window_max, acknowledged);
+
+			m_window_max = std::min(std::max(m_window_max + (UTP_GAIN * target * factor), 
+				(double) UTP_WINDOW_MIN), (double) UTP_WINDOW_MAX);
+		}
+
+		void 
+		_orbit_utp_connection::close(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			m_connect = nullptr;
+			m_watch = nullptr;
+
+			if(m_closing) {
+				return;
+			}
+
+			m_closing = true;
+			m_close_deadline = utp_time() + ((uint64_t) UTP_CLOSE_TIMEOUT * UTP_USEC_PER_MSEC);
+
+			switch(m_state) {
+				case ORBIT_UTP_STATE_CONNECTED:
+					send_pending();
+					break;
+				case ORBIT_UTP_STATE_SYN_SENT:
+					m_state = ORBIT_UTP_STATE_NONE;
+					break;
+				default:
+					break;
+			}
+		}
+
+		void 
+		_orbit_utp_connection::detach(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if((m_state == ORBIT_UTP_STATE_CONNECTED) || (m_state == ORBIT_UTP_STATE_SYN_SENT)
+					|| ((m_state == ORBIT_UTP_STATE_FIN_SENT) && !m_flight.empty())) {
+				send(ORBIT_UTP_PACKET_RESET);
+			}
+
+			m_owner = NULL;
+
+			if(m_state != ORBIT_UTP_STATE_NONE) {
+				m_state = ORBIT_UTP_STATE_RESET;
+			}
+		}
+
+		uint32_t 
+		_orbit_utp_connection::handle(
+			__in const orbit_utp_header &header,
+			__in const uint8_t *input,
+			__in size_t length
+			)
+		{
+			uint32_t result = 0;
+			uint8_t type = header.type >> 4;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(type == ORBIT_UTP_PACKET_SYN) {
+
+				if(m_state == ORBIT_UTP_STATE_CONNECTED) {
+					send(ORBIT_UTP_PACKET_STATE);
+				}
+
+				return result;
+			}
+
+			m_timestamp_difference = (uint32_t) utp_time() - ntohl(header.timestamp);
+			m_window_peer = ntohl(header.window);
+
+			if(type == ORBIT_UTP_PACKET_RESET) {
+
+				if(m_state == ORBIT_UTP_STATE_SYN_SENT) {
+					m_connect_error = ECONNREFUSED;
+				}
+
+				m_state = ORBIT_UTP_STATE_RESET;
+
+				return (ORBIT_EVENT_READ | ORBIT_EVENT_HANGUP);
+			}
+
+			if(m_state == ORBIT_UTP_STATE_SYN_SENT) {
+
+				if(type != ORBIT_UTP_PACKET_STATE) {
+					return result;
+				}
+
+				m_acknowledge = ntohs(header.sequence) - 1;
+				m_state = ORBIT_UTP_STATE_CONNECTED;
+				result |= ORBIT_EVENT_WRITE;
+			}
+
+			acknowledge(ntohs(header.acknowledge), ntohl(header.timestamp_difference));
+
+			switch(type) {
+				case ORBIT_UTP_PACKET_DATA:
+					result |= receive(ntohs(header.sequence), input, length);
+					break;
+				case ORBIT_UTP_PACKET_FIN:
+					m_fin = true;
+					m_eof_sequence = ntohs(header.sequence);
+					result |= receive(m_eof_sequence, NULL, 0);
+					break;
+				default:
+					break;
+			}
+
+			send_pending();
+
+			if(m_blocked && ((m_send.size() - m_send_offset) < UTP_SEND_LEN)) {
+				m_blocked = false;
+				result |= ORBIT_EVENT_WRITE;
+			}
+
+			return result;
+		}
+
+		bool 
+		_orbit_utp_connection::is_connected(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return (m_state == ORBIT_UTP_STATE_CONNECTED);
+		}
+
+		bool 
+		_orbit_utp_connection::is_finished(
+			__in uint64_t now
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			return ((m_state == ORBIT_UTP_STATE_NONE) || (m_state == ORBIT_UTP_STATE_RESET)
+				|| ((m_state == ORBIT_UTP_STATE_FIN_SENT) && m_flight.empty())
+				|| (m_closing && (now >= m_close_deadline)));
+		}
+
+		void 
+		_orbit_utp_connection::notify(
+			__in const orbit_utp_connection_handle &self,
+			__in uint32_t events
+			)
+		{
+			int error = 0;
+			orbit_utp_connect_cb connect;
+			orbit_utp_event_cb watch;
+
+			{
+				SERIALIZE_CALL_RECUR(m_lock);
+
+				if(m_connect && (m_state != ORBIT_UTP_STATE_NONE)
+						&& (m_state != ORBIT_UTP_STATE_SYN_SENT)) {
+					connect.swap(m_connect);
+					error = m_connect_error;
+				} else if(events) {
+					watch = m_watch;
+				}
+			}
+
+			if(connect) {
+				connect(self, error);
+			} else if(watch) {
+				watch(self, events);
+			}
+		}
+
+		int 
+		_orbit_utp_connection::read(
+			__out uint8_t *output,
+			__in size_t length
+			)
+		{
+			size_t result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result = std::min(length, m_receive.size() - m_receive_offset);
+			if(result) {
+				memcpy(output, &m_receive[m_receive_offset], result);
+				m_receive_offset += result;
+
+				if(m_receive_offset == m_receive.size()) {
+					m_receive.clear();
+					m_receive_offset = 0;
+				} else if(m_receive_offset > (UTP_RECEIVE_LEN / 2)) {
+					m_receive.erase(m_receive.begin(), m_receive.begin() + m_receive_offset);
+					m_receive_offset = 0;
+				}
+
+				return result;
+			} else if(!length || m_eof) {
+				return 0;
+			} else if(m_state == ORBIT_UTP_STATE_RESET) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_RESET);
+			} else if(m_state == ORBIT_UTP_STATE_NONE) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_DISCONNECTED);
+			}
+
+			return UTP_AGAIN;
+		}
+
+		uint32_t 
+		_orbit_utp_connection::receive(
+			__in uint16_t sequence,
+			__in const uint8_t *input,
+			__in size_t length
+			)
+		{
+			uint32_t result = 0;
+			std::map<uint16_t, orbit_buf_t>::iterator iter;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if((m_receive.size() - m_receive_offset + m_reorder_length + length) > UTP_RECEIVE_LEN) {
+				send(ORBIT_UTP_PACKET_STATE);
+				return result;
+			}
+
+			if(sequence == (uint16_t) (m_acknowledge + 1)) {
+				m_receive.insert(m_receive.end(), input, input + length);
+				m_acknowledge = sequence;
+
+				for(iter = m_reorder.find(m_acknowledge + 1); iter != m_reorder.end(); 
+						iter = m_reorder.find(m_acknowledge + 1)) {
+					m_receive.insert(m_receive.end(), iter->second.begin(), iter->second.end());
+					m_acknowledge = iter->first;
+					m_reorder_length -= iter->second.size();
+					m_reorder.erase(iter);
+				}
+
+				if(m_fin && (m_acknowledge == m_eof_sequence)) {
+					m_eof = true;
+				}
+
+				result = ORBIT_EVENT_READ;
+			} else if(utp_before(m_acknowledge, sequence) 
+					&& (m_reorder.find(sequence) == m_reorder.end())) {
+				m_reorder[sequence] = orbit_buf_t(input, input + length);
+				m_reorder_length += length;
+			}
+
+			send(ORBIT_UTP_PACKET_STATE);
+
+			return result;
+		}
+
+		void 
+		_orbit_utp_connection::send(
+			__in orbit_utp_packet_t type,
+			__in_opt const uint8_t *input,
+			__in_opt size_t length
+			)
+		{
+			orbit_utp_packet packet;
+			orbit_utp_header header;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			memset(&header, 0, sizeof(header));
+			header.type = (type << 4) | UTP_VERSION;
+			header.connection = htons((type == ORBIT_UTP_PACKET_SYN) ? m_connection_receive : m_connection_send);
+			header.sequence = htons(m_sequence);
+
+			packet.data.resize(sizeof(header) + length);
+			memcpy(&packet.data[0], &header, sizeof(header));
+
+			if(length) {
+				memcpy(&packet.data[sizeof(header)], input, length);
+			}
+
+			packet.sequence = m_sequence;
+			packet.time = 0;
+			packet.transmissions = 0;
+
+			if((type == ORBIT_UTP_PACKET_STATE) || (type == ORBIT_UTP_PACKET_RESET)) {
+				send_packet(packet);
+			} else {
+				++m_sequence;
+				m_flight.push_back(packet);
+				m_flight_length += length;
+				send_packet(m_flight.back());
+			}
+		}
+
+		void 
+		_orbit_utp_connection::send_packet(
+			__inout orbit_utp_packet &packet
+			)
+		{
+			int error;
+			uint64_t now = utp_time();
+			orbit_utp_header *header = (orbit_utp_header *) &packet.data[0];
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			header->timestamp = htonl((uint32_t) now);
+			header->timestamp_difference = htonl(m_timestamp_difference);
+			header->window = htonl(UTP_RECEIVE_LEN - std::min((size_t) UTP_RECEIVE_LEN, 
+				m_receive.size() - m_receive_offset + m_reorder_length));
+			header->acknowledge = htons(m_acknowledge);
+			packet.time = now;
+			++packet.transmissions;
+
+			if(!m_owner) {
+				m_state = ORBIT_UTP_STATE_RESET;
+				return;
+			}
+
+			error = m_owner->transmit(m_peer, m_peer_length, &packet.data[0], packet.data.size());
+			if(error && (error != EAGAIN) && (error != EWOULDBLOCK) && (error != ENOBUFS)) {
+
+				if(m_state == ORBIT_UTP_STATE_SYN_SENT) {
+					m_connect_error = error;
+				}
+
+				m_state = ORBIT_UTP_STATE_RESET;
+			}
+		}
+
+		void 
+		_orbit_utp_connection::send_pending(void)
+		{
+			size_t length;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			while((m_state == ORBIT_UTP_STATE_CONNECTED) && (m_send.size() > m_send_offset)) {
+				length = std::min((size_t) UTP_PACKET_LEN, m_send.size() - m_send_offset);
+
+				if(!m_flight.empty()
+						&& ((m_flight_length + length) > std::min(m_window_max, m_window_peer))) {
+					break;
+				}
+
+				send(ORBIT_UTP_PACKET_DATA, &m_send[m_send_offset], length);
+				m_send_offset += length;
+			}
+
+			if(m_send_offset == m_send.size()) {
+				m_send.clear();
+				m_send_offset = 0;
+
+				if(m_closing && (m_state == ORBIT_UTP_STATE_CONNECTED)) {
+					send(ORBIT_UTP_PACKET_FIN);
+					m_state = ORBIT_UTP_STATE_FIN_SENT;
+				}
+			} else if(m_send_offset > (UTP_SEND_LEN / 2)) {
+				m_send.erase(m_send.begin(), m_send.begin() + m_send_offset);
+				m_send_offset = 0;
+			}
+		}
+
+		orbit_utp_state_t 
+		_orbit_utp_connection::state(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_state;
+		}
+
+		uint32_t 
+		_orbit_utp_connection::timeout(
+			__in uint64_t now
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if((m_state == ORBIT_UTP_STATE_NONE) || (m_state == ORBIT_UTP_STATE_RESET)) {
+				return 0;
+			}
+
+			if((m_state == ORBIT_UTP_STATE_SYN_SENT) && (now >= m_connect_deadline)) {
+				m_connect_error = ETIMEDOUT;
+				m_state = ORBIT_UTP_STATE_RESET;
+				return ORBIT_EVENT_HANGUP;
+			}
+
+			if(m_flight.empty() || ((now - m_flight.front().time) < m_rto)) {
+				return 0;
+			}
+
+			if(m_flight.front().transmissions >= UTP_TRANSMISSION_MAX) {
+
+				if(m_state == ORBIT_UTP_STATE_SYN_SENT) {
+					m_connect_error = ETIMEDOUT;
+				}
+
+				m_state = ORBIT_UTP_STATE_RESET;
+
+				return (ORBIT_EVENT_READ | ORBIT_EVENT_HANGUP);
+			}
+
+			m_recover = m_sequence - 1;
+			m_recovering = true;
+			m_rto = std::min(m_rto * 2, (uint64_t) UTP_RTO_MAX);
+			m_window_max = UTP_WINDOW_MIN;
+			send_packet(m_flight.front());
+
+			return 0;
+		}
+
+		std::string 
+		_orbit_utp_connection::to_string(
+			__in_opt bool verbose
+			)
+		{
+			std::stringstream result;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			result << ORBIT_UTP_HEADER;
+
+			if(verbose) {
+				result << " (" << VALUE_AS_HEX(uintptr_t, this) << ")";
+			}
+
+			result << " [" << ORBIT_UTP_STATE_STRING(m_state) << "] wnd: " << m_window_max 
+				<< ", flight: " << m_flight_length << ", rtt: " << m_rtt;
+
+			return CHECK_STR(result.str());
+		}
+
+		void 
+		_orbit_utp_connection::unwatch(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			m_watch = nullptr;
+		}
+
+		void 
+		_orbit_utp_connection::watch(
+			__in const orbit_utp_event_cb &callback
+			)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			m_watch = callback;
+		}
+
+		uint32_t 
+		_orbit_utp_connection::window(void)
+		{
+			SERIALIZE_CALL_RECUR(m_lock);
+			return m_window_max;
+		}
+
+		int 
+		_orbit_utp_connection::write(
+			__in const uint8_t *input,
+			__in size_t length
+			)
+		{
+			size_t pending;
+
+			SERIALIZE_CALL_RECUR(m_lock);
+
+			if(m_state == ORBIT_UTP_STATE_RESET) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_RESET);
+			} else if((m_state != ORBIT_UTP_STATE_CONNECTED) || m_closing) {
+				THROW_ORBIT_UTP_EXCEPTION(ORBIT_UTP_EXCEPTION_DISCONNECTED);
+			}
+
+			pending = m_send.size() - m_send_offset;
+			if(length && (pending >= UTP_SEND_LEN)) {
+				m_blocked = true;
+				return UTP_AGAIN;
+			}
+
+			length = std::min(length, (size_t) UTP_SEND_LEN - pending);
+			m_send.insert(m_send.end(), input, input + length);
+			send_pending();
+
+			return length;
+		}
+	}
+}